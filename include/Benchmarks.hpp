@@ -26,6 +26,11 @@ class Benchmarks {
 
     void executeAllBenchmarks();
 
+    // Compression ratio and codec bandwidth per value distribution, compared to sending the chunk raw over the link
+    void execCompressionBenchmark();
+    // Scan bandwidth of every operator per type, selectivity and detected SIMD level
+    void execSelectionBenchmark();
+
     static const size_t OPTIMAL_BLOCK_SIZE = 65536;
 
    private:
@@ -43,6 +48,7 @@ class Benchmarks {
     void execRDMAHashJoinBenchmark();
     void execRDMAHashJoinPGBenchmark();
     void execRDMAHashJoinStarBenchmark();
+    void execSSBBenchmark();
 
     static const size_t WORKER_NUMBER = 8;
     Worker workers[WORKER_NUMBER];
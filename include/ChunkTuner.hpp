@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/* Per-column controller for the size of chunk requests.
+ * Chunk size starts small and doubles (slow start) as long as the consumer stalls and the measured bandwidth keeps up.
+ * After the first sign of degradation it switches to additive increase / multiplicative decrease:
+ * - consumer stalled and bandwidth did not drop -> chunk_size += MIN_CHUNK_SIZE
+ * - bandwidth dropped below DECREASE_FACTOR of the smoothed bandwidth -> chunk_size /= 2
+ * - consumer never waited -> keep the current size, data arrives in time.
+ * The prefetch threshold is raised to the full chunk size after a stall and decays while the consumer keeps up.
+ * All members are expected to be accessed while holding the owning column's iteratorLock.
+ */
+class ChunkTuner {
+   public:
+    static const size_t MIN_CHUNK_SIZE = 1024 * 256;
+    static const size_t MAX_CHUNK_SIZE = 1024 * 1024 * 256;
+
+    void reset(const size_t initial_size) {
+        chunk_size = clamp(initial_size);
+        threshold = chunk_size;
+        slow_start = true;
+        smoothed_bandwidth = 0;
+        stalled = std::chrono::duration<double>::zero();
+    }
+
+    void on_stall(const std::chrono::duration<double> duration) {
+        stalled += duration;
+    }
+
+    /* Called once all bytes of a chunk arrived, returns the next chunk size.
+     * requested_at is the time the earliest request answered by the chunk was issued, several requests are in flight with striping.
+     */
+    size_t on_chunk_received(const size_t bytes, const std::chrono::high_resolution_clock::time_point requested_at) {
+        if (requested_at == std::chrono::high_resolution_clock::time_point{}) {
+            return chunk_size;
+        }
+        const std::chrono::duration<double> latency = std::chrono::high_resolution_clock::now() - requested_at;
+        if (latency.count() <= 0) {
+            return chunk_size;
+        }
+        const double bandwidth = bytes / latency.count();
+
+        if (smoothed_bandwidth > 0 && bandwidth < smoothed_bandwidth * DECREASE_FACTOR) {
+            slow_start = false;
+            chunk_size = clamp(chunk_size / 2);
+        } else if (stalled.count() > 0) {
+            chunk_size = clamp(slow_start ? chunk_size * 2 : chunk_size + MIN_CHUNK_SIZE);
+        }
+
+        smoothed_bandwidth = (smoothed_bandwidth > 0) ? (1 - SMOOTHING) * smoothed_bandwidth + SMOOTHING * bandwidth : bandwidth;
+
+        // Request earlier after a stall, otherwise slowly move the request point closer to the end of the readable data.
+        threshold = (stalled.count() > 0) ? chunk_size : clamp(threshold - threshold / 4);
+        if (threshold > chunk_size) {
+            threshold = chunk_size;
+        }
+
+        stalled = std::chrono::duration<double>::zero();
+        return chunk_size;
+    }
+
+    size_t chunk_size = MIN_CHUNK_SIZE;
+    size_t threshold = MIN_CHUNK_SIZE;
+
+   private:
+    static constexpr double DECREASE_FACTOR = 0.7;
+    static constexpr double SMOOTHING = 0.25;
+
+    static size_t clamp(const size_t size) {
+        if (size < MIN_CHUNK_SIZE) return MIN_CHUNK_SIZE;
+        if (size > MAX_CHUNK_SIZE) return MAX_CHUNK_SIZE;
+        return size;
+    }
+
+    bool slow_start = true;
+    double smoothed_bandwidth = 0;
+    std::chrono::duration<double> stalled = std::chrono::duration<double>::zero();
+};
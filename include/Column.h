@@ -4,18 +4,24 @@
 #include <condition_variable>
 #include <cstdint>
 #include <cstring>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 #include <Logger.h>
 #include <numa.h>
 
+#include "ChunkTuner.hpp"
 #include "DataCatalog.h"
+#include "RangeFuture.hpp"
 
 struct col_t {
     template <typename T, bool chunk_iterator>
     struct col_iterator_t {
        public:
         col_iterator_t(col_t* p_col, T* p_data)
-            : col{p_col}, data{p_data} {
+            : col{p_col}, data{p_data}, consumed{p_data} {
                               // Nothing else to do for now.
                           };
 
@@ -29,7 +35,8 @@ struct col_t {
 
         void request_next() {
             if (chunk_iterator) {
-                if (!col->is_complete && reinterpret_cast<char*>(col->current_end) <= reinterpret_cast<char*>(data) + DataCatalog::getInstance().dataCatalog_chunkThreshold) {
+                const size_t threshold = DataCatalog::getInstance().dataCatalog_adaptiveChunking ? col->chunk_tuner.threshold : DataCatalog::getInstance().dataCatalog_chunkThreshold;
+                if (!col->is_complete && reinterpret_cast<char*>(col->current_end) <= reinterpret_cast<char*>(data) + threshold) {
                     col->request_data(!chunk_iterator);
                 }
             }
@@ -42,12 +49,32 @@ struct col_t {
             ) {
                 std::unique_lock<std::mutex> lk(col->iteratorLock);
                 LOG_DEBUG2("Stalling <" << (chunk_iterator ? "Chunked>" : "Full>") << std::endl;)
-                col->iterator_data_available.wait(lk, [this] { return reinterpret_cast<char*>(data) < reinterpret_cast<char*>(col->current_end); });
+                auto s_ts = std::chrono::high_resolution_clock::now();
+                col->iterator_data_available.wait(lk, [this] { return reinterpret_cast<char*>(data) < reinterpret_cast<char*>(col->current_end) || col->retired; });
+                col->chunk_tuner.on_stall(std::chrono::high_resolution_clock::now() - s_ts);
+                if (reinterpret_cast<char*>(data) == reinterpret_cast<char*>(col->current_end)) {
+                    // Retired column, end the scan instead of reading data that will never arrive
+                    LOG_ERROR("[col_t] Column " << col->ident << " was replaced on the provider while being scanned, stopping the scan." << std::endl;)
+                    data = reinterpret_cast<T*>(reinterpret_cast<char*>(col->data) + col->sizeInBytes);
+                }
+            }
+        }
+
+        // Gives the receive budget of the elements passed since the last call back, in steps of CONSUME_GRANULARITY bytes
+        void release_consumed() {
+            const size_t passed = reinterpret_cast<char*>(data) - reinterpret_cast<char*>(consumed);
+            const bool at_end = reinterpret_cast<char*>(data) == reinterpret_cast<char*>(col->data) + col->sizeInBytes;
+            if (passed >= CONSUME_GRANULARITY || (at_end && passed > 0)) {
+                col->consume(passed);
+                consumed = data;
             }
         }
 
         col_iterator_t& operator++() {
             data++;
+            if (DataCatalog::getInstance().dataCatalog_receiveBudget > 0) {
+                release_consumed();
+            }
             request_next();
             check_end();
             return *this;
@@ -68,8 +95,11 @@ struct col_t {
         };
 
        private:
+        static const size_t CONSUME_GRANULARITY = 1024 * 256;
+
         T* data;
         col_t* col;
+        T* consumed;
     };
 
     void* data = nullptr;
@@ -81,13 +111,58 @@ struct col_t {
     std::string ident = "";
     bool is_remote = false;
     bool is_complete = false;
+    // Replaced on the provider with another shape, no more data arrives. Set by DataCatalog::retireColumn under iteratorLock
+    bool retired = false;
     size_t requested_chunks = 0;
     size_t received_chunks = 0;
+    size_t requested_bytes = 0;
+    // Received bytes per chunk offset, and completed chunks waiting for an earlier chunk before becoming readable
+    std::unordered_map<size_t, size_t> chunk_progress;
+    std::map<size_t, size_t> completed_chunks;
+    struct requested_range_t {
+        size_t size;
+        std::chrono::high_resolution_clock::time_point requested_at;
+    };
+    // Ranges of the requests in flight and when they were issued, keyed by offset
+    std::map<size_t, requested_range_t> requested_ranges;
     std::mutex iteratorLock;
     std::mutex appendLock;
     std::condition_variable iterator_data_available;
+    // Adapts the size of chunk requests, only used with DataCatalog::dataCatalog_adaptiveChunking
+    ChunkTuner chunk_tuner;
+    // Whether the provider was told to write directly into data, only used with DataCatalog::dataCatalog_directReceive
+    bool direct_region_announced = false;
+    // Priority of the query reading this column, shared columns should carry the highest priority of their readers
+    request_priority_t priority = request_priority_t::normal;
+    // Part of DataCatalog::dataCatalog_receiveBudget taken by requests of this column and not yet given back by consume
+    size_t budget_held = 0;
+    // End of the bytes given back by consume_until
+    size_t consumed_offset = 0;
+    // Futures of requested ranges keyed by the byte offset that has to become readable, and futures that are ready to complete
+    std::multimap<size_t, std::shared_ptr<RangeFuture::state_t>> range_waiters;
+    std::vector<std::shared_ptr<RangeFuture::state_t>> ready_ranges;
 
     ~col_t() {
+        if (is_remote) {
+            DataCatalog::getInstance().forgetBudget(this, budget_held);
+        }
+        /* Every outstanding future fails, also those whose range already arrived: the data is freed below and a posted
+         * continuation (e.g. a morsel resumed by PipelineExecutor) may only run afterwards. Inline continuations run here,
+         * before the memory is released, and are told not to touch it either.
+         */
+        std::vector<std::shared_ptr<RangeFuture::state_t>> outstanding;
+        {
+            std::lock_guard<std::mutex> _lk(iteratorLock);
+            for (auto& waiter : range_waiters) {
+                outstanding.push_back(std::move(waiter.second));
+            }
+            range_waiters.clear();
+            outstanding.insert(outstanding.end(), ready_ranges.begin(), ready_ranges.end());
+            ready_ranges.clear();
+        }
+        for (auto& state : outstanding) {
+            RangeFuture::complete(state, false);
+        }
         // May be a problem when freeing memory not allocated with numa_alloc
         numa_free(data, sizeInBytes);
     }
@@ -114,7 +189,10 @@ struct col_t {
     template <typename T, bool chunked>
     col_iterator_t<T, chunked> begin() {
         std::unique_lock<std::mutex> lk(iteratorLock);
-        iterator_data_available.wait(lk, [this] { return current_end != data; });
+        iterator_data_available.wait(lk, [this] { return current_end != data || retired; });
+        if (current_end == data) {
+            return end<T, chunked>();
+        }
         return col_iterator_t<T, chunked>(
             this,
             static_cast<T*>(data));
@@ -182,16 +260,172 @@ struct col_t {
         current_end = data;
     }
 
-    void request_data(bool fetch_complete_column) {
+    /* Checks whether a new request is allowed and does the bookkeeping for it, the caller sends the actual request.
+     * Up to DataCatalog::dataCatalog_stripeWidth chunk requests per replica may be in flight. A whole column request is
+     * exclusive, unless the column has several replicas: then it is split into one equally sized range per replica.
+     * chunk_offset and chunk_size are set to the byte range the request will deliver.
+     */
+    bool prepare_request(bool fetch_complete_column, const size_t replicas, size_t& chunk_offset, size_t& chunk_size) {
         std::unique_lock<std::mutex> _lk(iteratorLock);
-        if (is_complete || requested_chunks > received_chunks) {
+        const bool split_scan = fetch_complete_column && replicas > 1;
+        const size_t max_inflight = split_scan ? replicas : (fetch_complete_column ? 1 : DataCatalog::getInstance().dataCatalog_stripeWidth * replicas);
+        if (is_complete || retired || requested_bytes >= sizeInBytes || requested_chunks - received_chunks >= max_inflight) {
             LOG_DEBUG2("<data request ignored: " << (is_complete ? "is_complete" : "not_complete") << ">" << std::endl;)
             // Do Nothing, ignore.
-            return;
+            return false;
+        }
+        chunk_size = DataCatalog::getInstance().dataCatalog_chunkMaxSize;
+        if (DataCatalog::getInstance().dataCatalog_adaptiveChunking) {
+            if (requested_chunks == 0) {
+                chunk_tuner.reset(chunk_size);
+            }
+            chunk_size = chunk_tuner.chunk_size;
         }
+        if (split_scan) {
+            chunk_size = (sizeInBytes + replicas - 1) / replicas;
+        }
+        const size_t remaining_bytes = sizeInBytes - requested_bytes;
+        if ((fetch_complete_column && !split_scan) || chunk_size > remaining_bytes) {
+            chunk_size = remaining_bytes;
+        }
+        // Without budget the column is parked and requested again once a scan gives budget back
+        if (!DataCatalog::getInstance().acquireBudget(this, chunk_size, fetch_complete_column)) {
+            return false;
+        }
+        budget_held += chunk_size;
+        chunk_offset = requested_bytes;
+        requested_ranges.emplace(chunk_offset, requested_range_t{chunk_size, std::chrono::high_resolution_clock::now()});
+        requested_bytes += chunk_size;
         ++requested_chunks;
 
-        DataCatalog::getInstance().fetchColStub(1, ident, fetch_complete_column);
+        if (DataCatalog::getInstance().dataCatalog_directReceive && !direct_region_announced) {
+            DataCatalog::getInstance().announceDirectRegion(this);
+            direct_region_announced = true;
+        }
+        return true;
+    }
+
+    // Issues as many requests as allowed, each one is routed to the least loaded replica of the column by the catalog's scheduler
+    void request_data(bool fetch_complete_column) {
+        const size_t replicas = DataCatalog::getInstance().getProviders(ident).size();
+        const bool whole_request = fetch_complete_column && replicas <= 1;
+        size_t chunk_offset;
+        size_t chunk_size;
+        while (prepare_request(fetch_complete_column, replicas, chunk_offset, chunk_size)) {
+            const std::size_t conId = DataCatalog::getInstance().scheduleConnection(ident, chunk_size);
+            DataCatalog::getInstance().submitRequest(conId, ident, whole_request, chunk_size, chunk_offset, priority);
+        }
+    }
+
+    /* Requests the bytes [offset, offset + size) and returns a future that completes once they are readable.
+     * Data only becomes readable in order, so the future waits for everything up to offset + size.
+     * Chunked columns keep requesting chunks on their own as long as futures are waiting, no consumer has to iterate.
+     */
+    RangeFuture request_range(size_t offset, size_t size, bool fetch_complete_column = false) {
+        auto state = std::make_shared<RangeFuture::state_t>();
+        const size_t range_end = (offset + size < sizeInBytes) ? offset + size : sizeInBytes;
+        {
+            std::lock_guard<std::mutex> _lk(iteratorLock);
+            const size_t readable = reinterpret_cast<char*>(current_end) - reinterpret_cast<char*>(data);
+            if (is_remote && !is_complete && readable < range_end) {
+                if (retired) {
+                    // Fails right away, the range never arrives
+                    state->done = true;
+                    return RangeFuture(state);
+                }
+                range_waiters.emplace(range_end, state);
+            } else {
+                state->done = true;
+                state->resident = true;
+            }
+        }
+        if (!state->done) {
+            request_data(fetch_complete_column);
+        }
+        return RangeFuture(state);
+    }
+
+    /* Completes the futures whose range became readable and, with keep_fetching, requests further chunks while futures are still waiting.
+     * Must be called without holding iteratorLock, continuations of the futures run on the calling thread.
+     */
+    void dispatch_ready_ranges(bool keep_fetching = true) {
+        std::vector<std::shared_ptr<RangeFuture::state_t>> ready;
+        bool waiting;
+        size_t released = 0;
+        {
+            std::lock_guard<std::mutex> _lk(iteratorLock);
+            ready.swap(ready_ranges);
+            waiting = !range_waiters.empty();
+            // A complete column requests nothing anymore, scans that never consume must not keep its budget
+            if (is_complete) {
+                released = budget_held;
+                budget_held = 0;
+            }
+        }
+        if (released > 0) {
+            DataCatalog::getInstance().releaseBudget(released);
+        }
+        for (auto& state : ready) {
+            RangeFuture::complete(state, true);
+        }
+        if (waiting && keep_fetching) {
+            request_data(false);
+        }
+    }
+
+    /* Called by scans for bytes they are done with, the budget taken for them becomes available to further requests.
+     * Consumed data stays readable, later scans of the column do not request it again.
+     */
+    void consume(size_t bytes) {
+        size_t released;
+        {
+            std::lock_guard<std::mutex> _lk(iteratorLock);
+            released = (bytes < budget_held) ? bytes : budget_held;
+            budget_held -= released;
+        }
+        if (released > 0) {
+            DataCatalog::getInstance().releaseBudget(released);
+        }
+    }
+
+    // Called by scans reading the column front to back: all bytes before offset are consumed, bytes consumed before are not counted twice
+    void consume_until(size_t offset) {
+        size_t bytes = 0;
+        {
+            std::lock_guard<std::mutex> _lk(iteratorLock);
+            if (offset > consumed_offset) {
+                bytes = offset - consumed_offset;
+                consumed_offset = offset;
+            }
+        }
+        if (bytes > 0) {
+            consume(bytes);
+        }
+    }
+
+    /* Returns the number of requests answered by a completed range, the provider may merge adjacent requests.
+     * requested_at is set to the issue time of the earliest answered request, or left default if none was recorded. Expects iteratorLock to be held.
+     */
+    size_t settle_requests(size_t offset, size_t chunkSize, std::chrono::high_resolution_clock::time_point& requested_at) {
+        size_t answered = 0;
+        requested_at = {};
+        for (auto it = requested_ranges.lower_bound(offset); it != requested_ranges.end() && it->first < offset + chunkSize; it = requested_ranges.erase(it)) {
+            if (answered == 0 || it->second.requested_at < requested_at) {
+                requested_at = it->second.requested_at;
+            }
+            ++answered;
+        }
+        return (answered > 0) ? answered : 1;
+    }
+
+    // Marks a chunk as received and advances the readable end over all contiguous chunks. Expects iteratorLock to be held.
+    void complete_chunk(size_t offset, size_t chunkSize) {
+        completed_chunks.emplace(offset, chunkSize);
+        size_t readable = reinterpret_cast<char*>(current_end) - reinterpret_cast<char*>(data);
+        for (auto it = completed_chunks.begin(); it != completed_chunks.end() && it->first == readable; it = completed_chunks.erase(it)) {
+            readable += it->second;
+            advance_end_pointer(it->second);
+        }
     }
 
     void append_chunk(size_t offset, size_t chunkSize, char* remoteData) {
@@ -202,8 +436,34 @@ struct col_t {
         memcpy(reinterpret_cast<char*>(data) + offset, remoteData, chunkSize);
     }
 
+    // Decodes a compressed block of chunkSize (uncompressed) bytes straight into the column buffer at offset.
+    bool append_compressed_chunk(size_t offset, size_t chunkSize, chunk_codec_t codec, const char* remoteData, size_t remoteSize) {
+        if (data == nullptr) {
+            LOG_WARNING("!!! Implement allocation handling in append_compressed_chunk, aborting." << std::endl;)
+            return false;
+        }
+        char* target = reinterpret_cast<char*>(data) + offset;
+        switch (datatype) {
+            case col_data_t::gen_smallint: {
+                return Compression::decompress<uint8_t>(codec, remoteData, remoteSize, reinterpret_cast<uint8_t*>(target), chunkSize / sizeof(uint8_t));
+            }
+            case col_data_t::gen_bigint: {
+                return Compression::decompress<uint64_t>(codec, remoteData, remoteSize, reinterpret_cast<uint64_t*>(target), chunkSize / sizeof(uint64_t));
+            }
+            default: {
+                LOG_WARNING("Compressed chunk received for a column type without codec support, aborting." << std::endl;)
+                return false;
+            }
+        }
+    }
+
+    // Expects iteratorLock to be held, futures of ranges that became readable are completed by dispatch_ready_ranges
     void advance_end_pointer(size_t size) {
         current_end = reinterpret_cast<void*>(reinterpret_cast<char*>(current_end) + size);
+        const size_t readable = reinterpret_cast<char*>(current_end) - reinterpret_cast<char*>(data);
+        for (auto it = range_waiters.begin(); it != range_waiters.end() && it->first <= readable; it = range_waiters.erase(it)) {
+            ready_ranges.push_back(std::move(it->second));
+        }
         iterator_data_available.notify_all();
     }
 
@@ -359,12 +619,15 @@ struct table_t {
 
     explicit table_t(std::string _ident, size_t _onNode) : ident{_ident}, numCols{0}, numRows{0}, onNode{_onNode}, bufferRatio{0}, isFactTable{true} {};
 
-    table_t(std::string _ident, size_t _numCols, size_t _numRows, size_t _onNode, size_t _bufferRatio, bool _isFactTable) : ident{_ident}, numCols{_numCols}, numRows{_numRows}, onNode{_onNode}, bufferRatio{_bufferRatio}, isFactTable{_isFactTable} {
+    // Column 0 is the key 0..numRows-1, the other columns follow spec within the foreign key range of the table kind
+    table_t(std::string _ident, size_t _numCols, size_t _numRows, size_t _onNode, size_t _bufferRatio, bool _isFactTable, const gen_spec_t& spec = {}) : ident{_ident}, numCols{_numCols}, numRows{_numRows}, onNode{_onNode}, bufferRatio{_bufferRatio}, isFactTable{_isFactTable} {
         for (size_t i = 0; i < numCols; ++i) {
             columns.emplace_back(new col_t);
         }
 
-        std::default_random_engine generator;
+        gen_spec_t value_spec = spec;
+        value_spec.lower = 0;
+        value_spec.upper = isFactTable ? std::max(std::floor(numRows * bufferRatio * 0.01) - 1, 0.0) : 100;
 
         uint8_t colId = 0;
 
@@ -387,21 +650,14 @@ struct table_t {
             auto data = reinterpret_cast<uint64_t*>(col->data);
 
             if (colId == 0) {
+#pragma omp parallel for schedule(static)
                 for (size_t i = 0; i < numRows; ++i) {
                     data[i] = i;
                 }
             } else {
-                std::uniform_int_distribution<uint64_t> distribution;
-
-                if (isFactTable) {
-                    distribution = std::uniform_int_distribution<uint64_t>(0, (numRows * bufferRatio * 0.01) - 1);
-                } else {
-                    distribution = std::uniform_int_distribution<uint64_t>(0, 100);
-                }
-
-                for (size_t i = 0; i < numRows; ++i) {
-                    data[i] = distribution(generator);
-                }
+                // Correlated columns follow their left neighbour
+                const auto previous = reinterpret_cast<const uint64_t*>(columns[colId - 1]->data);
+                DataGenerator::fill(data, numRows, value_spec, static_cast<uint32_t>(std::hash<std::string>{}(col->ident)), previous);
             }
 
             if (col->is_complete) {
@@ -461,6 +717,20 @@ struct table_t {
         ++numCols;
     }
 
+    // Takes over an already filled column under its own ident
+    void addColumn(col_t* col) {
+        if (numRows == 0) {
+            numRows = col->size;
+        } else if (numRows != col->size) {
+            LOG_ERROR("Dimension of column does not match with table!" << std::endl;)
+            return;
+        }
+
+        columns.emplace_back(col);
+
+        ++numCols;
+    }
+
     col_t* getPrimaryKeyColumn() {
         return columns[0];
     }
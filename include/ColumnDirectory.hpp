@@ -0,0 +1,206 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct col_t;
+
+typedef std::unordered_map<std::string, col_t*> col_dict_t;
+typedef uint32_t col_handle_t;
+constexpr col_handle_t INVALID_COL_HANDLE = std::numeric_limits<col_handle_t>::max();
+
+/* Concurrent ident -> column map of the catalog.
+ * Idents are spread over SHARDS independently locked shards, so parallel inserts (e.g. generate from an omp loop) and
+ * lookups only contend on the same shard. Hot paths should intern an ident once with handle(ident) and use
+ * resolve(handle) afterwards, which is a wait-free load without hashing or locking.
+ * A handle stays bound to its ident: it resolves to nullptr while no column of that name exists and to the new column
+ * once the ident is inserted again. Like before, a returned column is only valid until it is erased.
+ */
+class ColumnDirectory {
+   public:
+    ColumnDirectory() = default;
+    ColumnDirectory(ColumnDirectory const&) = delete;
+    void operator=(ColumnDirectory const&) = delete;
+
+    ~ColumnDirectory() {
+        for (auto& segment : segments) {
+            delete[] segment.load();
+        }
+    }
+
+    col_t* find(const std::string& ident) const {
+        const shard_t& shard = shardOf(ident);
+        std::shared_lock<std::shared_mutex> lk(shard.lock);
+        auto it = shard.entries.find(ident);
+        return (it != shard.entries.end()) ? it->second.col : nullptr;
+    }
+
+    // Returns the column stored under ident and whether col was inserted, an existing column is kept
+    std::pair<col_t*, bool> insert(const std::string& ident, col_t* col) {
+        shard_t& shard = shardOf(ident);
+        std::unique_lock<std::shared_mutex> lk(shard.lock);
+        entry_t& entry = shard.entries[ident];
+        if (entry.col) {
+            return {entry.col, false};
+        }
+        entry.col = col;
+        if (entry.handle != INVALID_COL_HANDLE) {
+            slot(entry.handle).store(col, std::memory_order_release);
+        }
+        ++count;
+        return {col, true};
+    }
+
+    // Returns the removed column, the caller owns it
+    col_t* erase(const std::string& ident) {
+        shard_t& shard = shardOf(ident);
+        std::unique_lock<std::shared_mutex> lk(shard.lock);
+        auto it = shard.entries.find(ident);
+        if (it == shard.entries.end() || !it->second.col) {
+            return nullptr;
+        }
+        col_t* col = unbind(it->second);
+        // Interned idents keep their entry, so the handle can bind to a later column of the same name
+        if (it->second.handle == INVALID_COL_HANDLE) {
+            shard.entries.erase(it);
+        }
+        return col;
+    }
+
+    // Removes all columns and returns them, handles stay valid
+    std::vector<col_t*> clear() {
+        std::vector<col_t*> removed;
+        for (auto& shard : shards) {
+            std::unique_lock<std::shared_mutex> lk(shard.lock);
+            for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+                if (it->second.col) {
+                    removed.push_back(unbind(it->second));
+                }
+                it = (it->second.handle == INVALID_COL_HANDLE) ? shard.entries.erase(it) : std::next(it);
+            }
+        }
+        return removed;
+    }
+
+    size_t size() const {
+        return count.load();
+    }
+
+    // Calls fn(ident, col) for every column, holding one shard at a time. fn must not modify the directory.
+    void for_each(const std::function<void(const std::string&, col_t*)>& fn) const {
+        for (auto& shard : shards) {
+            std::shared_lock<std::shared_mutex> lk(shard.lock);
+            for (auto& entry : shard.entries) {
+                if (entry.second.col) {
+                    fn(entry.first, entry.second.col);
+                }
+            }
+        }
+    }
+
+    col_dict_t snapshot() const {
+        col_dict_t result;
+        for_each([&result](const std::string& ident, col_t* col) { result.emplace(ident, col); });
+        return result;
+    }
+
+    // Interns ident, the handle may be taken before the column exists
+    col_handle_t handle(const std::string& ident) {
+        shard_t& shard = shardOf(ident);
+        std::unique_lock<std::shared_mutex> lk(shard.lock);
+        entry_t& entry = shard.entries[ident];
+        if (entry.handle == INVALID_COL_HANDLE) {
+            const col_handle_t handle = allocateHandle();
+            if (handle == INVALID_COL_HANDLE) {
+                return INVALID_COL_HANDLE;
+            }
+            entry.handle = handle;
+            slot(handle).store(entry.col, std::memory_order_release);
+        }
+        return entry.handle;
+    }
+
+    // Handle of an already interned ident, INVALID_COL_HANDLE otherwise
+    col_handle_t find_handle(const std::string& ident) const {
+        const shard_t& shard = shardOf(ident);
+        std::shared_lock<std::shared_mutex> lk(shard.lock);
+        auto it = shard.entries.find(ident);
+        return (it != shard.entries.end()) ? it->second.handle : INVALID_COL_HANDLE;
+    }
+
+    col_t* resolve(const col_handle_t handle) const {
+        if (handle >= next_handle.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return slot(handle).load(std::memory_order_acquire);
+    }
+
+   private:
+    static constexpr size_t SHARDS = 16;
+    static constexpr size_t SEGMENT_BITS = 12;
+    static constexpr size_t SEGMENT_SIZE = size_t{1} << SEGMENT_BITS;
+    static constexpr size_t MAX_SEGMENTS = 1024;
+
+    struct entry_t {
+        col_t* col = nullptr;
+        col_handle_t handle = INVALID_COL_HANDLE;
+    };
+
+    struct alignas(64) shard_t {
+        mutable std::shared_mutex lock;
+        std::unordered_map<std::string, entry_t> entries;
+    };
+
+    shard_t& shardOf(const std::string& ident) {
+        return shards[std::hash<std::string>{}(ident) % SHARDS];
+    }
+
+    const shard_t& shardOf(const std::string& ident) const {
+        return shards[std::hash<std::string>{}(ident) % SHARDS];
+    }
+
+    // Expects the entry's shard lock to be held
+    col_t* unbind(entry_t& entry) {
+        col_t* col = entry.col;
+        entry.col = nullptr;
+        if (entry.handle != INVALID_COL_HANDLE) {
+            slot(entry.handle).store(nullptr, std::memory_order_release);
+        }
+        --count;
+        return col;
+    }
+
+    // Slots live in fixed size segments that are never moved, so resolve needs no lock
+    std::atomic<col_t*>& slot(const col_handle_t handle) const {
+        return segments[handle >> SEGMENT_BITS].load(std::memory_order_acquire)[handle & (SEGMENT_SIZE - 1)];
+    }
+
+    col_handle_t allocateHandle() {
+        std::lock_guard<std::mutex> lk(segmentLock);
+        const col_handle_t handle = next_handle.load();
+        if ((handle >> SEGMENT_BITS) >= MAX_SEGMENTS) {
+            return INVALID_COL_HANDLE;
+        }
+        auto& segment = segments[handle >> SEGMENT_BITS];
+        if (!segment.load()) {
+            segment.store(new std::atomic<col_t*>[SEGMENT_SIZE](), std::memory_order_release);
+        }
+        next_handle.store(handle + 1, std::memory_order_release);
+        return handle;
+    }
+
+    std::array<shard_t, SHARDS> shards;
+    std::atomic<size_t> count{0};
+    std::array<std::atomic<std::atomic<col_t*>*>, MAX_SEGMENTS> segments{};
+    std::atomic<col_handle_t> next_handle{0};
+    std::mutex segmentLock;
+};
@@ -0,0 +1,342 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+/* Lightweight codecs for shipping integer column chunks over the wire.
+ * All packed formats work on blocks of BLOCK_ELEMENTS values, a block of width b occupies exactly b 64bit words.
+ */
+enum class chunk_codec_t : uint8_t {
+    raw = 0,
+    for_bitpack,    // frame of reference (chunk minimum) + bit packing
+    delta_bitpack,  // zigzag encoded deltas + bit packing, good for sorted data
+    rle             // run-length encoding, good for long runs of equal values
+};
+
+class Compression {
+   public:
+    static const size_t BLOCK_ELEMENTS = 64;
+    static const size_t SAMPLE_RUNS = 16;
+    static const size_t SAMPLE_RUN_LENGTH = 64;
+    static const size_t HEADER_SIZE = 2 * sizeof(uint64_t);
+
+    struct estimate_t {
+        chunk_codec_t codec;
+        size_t bytes;
+    };
+
+    static std::string codec_to_string(chunk_codec_t codec) {
+        switch (codec) {
+            case chunk_codec_t::raw:
+                return "raw";
+            case chunk_codec_t::for_bitpack:
+                return "for_bitpack";
+            case chunk_codec_t::delta_bitpack:
+                return "delta_bitpack";
+            case chunk_codec_t::rle:
+                return "rle";
+            default:
+                return "Codec case not implemented!";
+        }
+    }
+
+    // Picks the codec with the smallest estimated size from a strided sample of the data.
+    // Returns raw if no codec saves at least a quarter of the raw size.
+    template <typename T>
+    static estimate_t choose_codec(const T* data, const size_t count) {
+        static_assert(std::is_unsigned<T>::value, "Only unsigned integer columns can be compressed.");
+        const size_t raw_bytes = count * sizeof(T);
+        if (count < BLOCK_ELEMENTS) {
+            return {chunk_codec_t::raw, raw_bytes};
+        }
+
+        const size_t runs = (count < SAMPLE_RUNS * SAMPLE_RUN_LENGTH) ? 1 : SAMPLE_RUNS;
+        const size_t run_length = (runs == 1) ? count : SAMPLE_RUN_LENGTH;
+        const size_t stride = count / runs;
+
+        uint64_t min = UINT64_MAX;
+        uint64_t max = 0;
+        uint64_t max_zigzag = 0;
+        size_t value_changes = 0;
+
+        for (size_t r = 0; r < runs; ++r) {
+            const T* run = data + r * stride;
+            for (size_t i = 0; i < run_length; ++i) {
+                const uint64_t v = run[i];
+                min = v < min ? v : min;
+                max = v > max ? v : max;
+                if (i > 0) {
+                    const uint64_t zz = zigzag(v - static_cast<uint64_t>(run[i - 1]));
+                    max_zigzag = zz > max_zigzag ? zz : max_zigzag;
+                    value_changes += (v != run[i - 1]);
+                }
+            }
+        }
+
+        const size_t sampled = runs * run_length;
+        const size_t packed_blocks = (count + BLOCK_ELEMENTS - 1) / BLOCK_ELEMENTS;
+        const size_t est_runs = 1 + (value_changes * count) / sampled;
+
+        estimate_t best = {chunk_codec_t::raw, raw_bytes};
+        const estimate_t candidates[] = {
+            {chunk_codec_t::for_bitpack, HEADER_SIZE + packed_blocks * std::bit_width(max - min) * sizeof(uint64_t)},
+            {chunk_codec_t::delta_bitpack, HEADER_SIZE + packed_blocks * std::bit_width(max_zigzag) * sizeof(uint64_t)},
+            {chunk_codec_t::rle, sizeof(uint64_t) + est_runs * (sizeof(uint64_t) + sizeof(uint32_t))}};
+
+        for (auto& c : candidates) {
+            if (c.bytes < best.bytes) {
+                best = c;
+            }
+        }
+
+        if (best.bytes * 4 > raw_bytes * 3) {
+            return {chunk_codec_t::raw, raw_bytes};
+        }
+        return best;
+    }
+
+    // Compresses count values into out. Returns the number of written bytes or 0 if the result
+    // would not fit into out_capacity or would not be smaller than the raw data.
+    template <typename T>
+    static size_t compress(const chunk_codec_t codec, const T* in, const size_t count, char* out, const size_t out_capacity) {
+        static_assert(std::is_unsigned<T>::value, "Only unsigned integer columns can be compressed.");
+        if (count == 0) {
+            return 0;
+        }
+        const size_t capacity = (out_capacity < count * sizeof(T)) ? out_capacity : count * sizeof(T) - 1;
+
+        switch (codec) {
+            case chunk_codec_t::for_bitpack: {
+                uint64_t min = UINT64_MAX;
+                uint64_t max = 0;
+                for (size_t i = 0; i < count; ++i) {
+                    min = in[i] < min ? in[i] : min;
+                    max = in[i] > max ? in[i] : max;
+                }
+                const uint64_t bits = std::bit_width(max - min);
+                return pack<T>(in, count, min, bits, capacity, out, [min](const T* block, size_t, uint64_t* residuals) {
+#pragma omp simd
+                    for (size_t j = 0; j < BLOCK_ELEMENTS; ++j) {
+                        residuals[j] = static_cast<uint64_t>(block[j]) - min;
+                    }
+                });
+            }
+            case chunk_codec_t::delta_bitpack: {
+                uint64_t max_zigzag = 0;
+                for (size_t i = 1; i < count; ++i) {
+                    const uint64_t zz = zigzag(static_cast<uint64_t>(in[i]) - in[i - 1]);
+                    max_zigzag = zz > max_zigzag ? zz : max_zigzag;
+                }
+                const uint64_t bits = std::bit_width(max_zigzag);
+                return pack<T>(in, count, in[0], bits, capacity, out, [in](const T* block, size_t block_start, uint64_t* residuals) {
+                    residuals[0] = (block_start == 0) ? 0 : zigzag(static_cast<uint64_t>(block[0]) - in[block_start - 1]);
+                    for (size_t j = 1; j < BLOCK_ELEMENTS; ++j) {
+                        residuals[j] = zigzag(static_cast<uint64_t>(block[j]) - block[j - 1]);
+                    }
+                });
+            }
+            case chunk_codec_t::rle: {
+                // [ run_cnt | value+ | length+ ]
+                size_t run_cnt = 0;
+                for (size_t i = 0; i < count; ++i) {
+                    run_cnt += (i == 0 || in[i] != in[i - 1]);
+                }
+                const size_t total = sizeof(uint64_t) + run_cnt * (sizeof(uint64_t) + sizeof(uint32_t));
+                if (total > capacity) {
+                    return 0;
+                }
+                memcpy(out, &run_cnt, sizeof(uint64_t));
+                char* values = out + sizeof(uint64_t);
+                char* lengths = values + run_cnt * sizeof(uint64_t);
+                size_t run = 0;
+                uint32_t len = 0;
+                for (size_t i = 0; i < count; ++i) {
+                    if (i > 0 && in[i] != in[i - 1]) {
+                        const uint64_t v = in[i - 1];
+                        memcpy(values + run * sizeof(uint64_t), &v, sizeof(uint64_t));
+                        memcpy(lengths + run * sizeof(uint32_t), &len, sizeof(uint32_t));
+                        ++run;
+                        len = 0;
+                    }
+                    ++len;
+                }
+                const uint64_t v = in[count - 1];
+                memcpy(values + run * sizeof(uint64_t), &v, sizeof(uint64_t));
+                memcpy(lengths + run * sizeof(uint32_t), &len, sizeof(uint32_t));
+                return total;
+            }
+            default:
+                return 0;
+        }
+    }
+
+    // Decompresses in_size bytes into exactly count values starting at out.
+    template <typename T>
+    static bool decompress(const chunk_codec_t codec, const char* in, const size_t in_size, T* out, const size_t count) {
+        static_assert(std::is_unsigned<T>::value, "Only unsigned integer columns can be compressed.");
+        switch (codec) {
+            case chunk_codec_t::raw: {
+                if (in_size != count * sizeof(T)) return false;
+                memcpy(out, in, in_size);
+                return true;
+            }
+            case chunk_codec_t::for_bitpack: {
+                return unpack<T>(in, in_size, out, count, [](const uint64_t base, const uint64_t* residuals, T* block, const size_t n) {
+#pragma omp simd
+                    for (size_t j = 0; j < n; ++j) {
+                        block[j] = static_cast<T>(base + residuals[j]);
+                    }
+                    return base;
+                });
+            }
+            case chunk_codec_t::delta_bitpack: {
+                return unpack<T>(in, in_size, out, count, [](uint64_t prev, const uint64_t* residuals, T* block, const size_t n) {
+                    for (size_t j = 0; j < n; ++j) {
+                        prev += unzigzag(residuals[j]);
+                        block[j] = static_cast<T>(prev);
+                    }
+                    return prev;
+                });
+            }
+            case chunk_codec_t::rle: {
+                if (in_size < sizeof(uint64_t)) return false;
+                uint64_t run_cnt;
+                memcpy(&run_cnt, in, sizeof(uint64_t));
+                // Bound run_cnt before multiplying so that a crafted header cannot overflow the size check
+                constexpr size_t run_size = sizeof(uint64_t) + sizeof(uint32_t);
+                if (run_cnt > (in_size - sizeof(uint64_t)) / run_size || in_size != sizeof(uint64_t) + run_cnt * run_size) return false;
+                const char* values = in + sizeof(uint64_t);
+                const char* lengths = values + run_cnt * sizeof(uint64_t);
+                size_t pos = 0;
+                for (size_t r = 0; r < run_cnt; ++r) {
+                    uint64_t v;
+                    uint32_t len;
+                    memcpy(&v, values + r * sizeof(uint64_t), sizeof(uint64_t));
+                    memcpy(&len, lengths + r * sizeof(uint32_t), sizeof(uint32_t));
+                    if (pos + len > count) return false;
+                    const T value = static_cast<T>(v);
+#pragma omp simd
+                    for (size_t j = 0; j < len; ++j) {
+                        out[pos + j] = value;
+                    }
+                    pos += len;
+                }
+                return pos == count;
+            }
+            default:
+                return false;
+        }
+    }
+
+   private:
+    static inline uint64_t zigzag(const uint64_t diff) {
+        const int64_t d = static_cast<int64_t>(diff);
+        return static_cast<uint64_t>((d << 1) ^ (d >> 63));
+    }
+
+    static inline uint64_t unzigzag(const uint64_t zz) {
+        return (zz >> 1) ^ (~(zz & 1) + 1);
+    }
+
+    /* Layout [ base | bits | [packed block]* ]
+     * residual_fn fills BLOCK_ELEMENTS residuals for the block starting at the given element.
+     */
+    template <typename T, typename Fn>
+    static size_t pack(const T* in, const size_t count, const uint64_t base, const uint64_t bits, const size_t capacity, char* out, Fn&& residual_fn) {
+        const size_t blocks = (count + BLOCK_ELEMENTS - 1) / BLOCK_ELEMENTS;
+        const size_t total = HEADER_SIZE + blocks * bits * sizeof(uint64_t);
+        if (total > capacity) {
+            return 0;
+        }
+
+        memcpy(out, &base, sizeof(uint64_t));
+        memcpy(out + sizeof(uint64_t), &bits, sizeof(uint64_t));
+        uint64_t* packed = reinterpret_cast<uint64_t*>(out + HEADER_SIZE);
+
+        uint64_t residuals[BLOCK_ELEMENTS];
+        T tail[BLOCK_ELEMENTS];
+        for (size_t b = 0; b < blocks; ++b) {
+            const size_t start = b * BLOCK_ELEMENTS;
+            const T* block = in + start;
+            if (count - start < BLOCK_ELEMENTS) {
+                // Pad the last block with its final value, the receiver only reads count values
+                const size_t n = count - start;
+                memcpy(tail, block, n * sizeof(T));
+                for (size_t j = n; j < BLOCK_ELEMENTS; ++j) {
+                    tail[j] = block[n - 1];
+                }
+                block = tail;
+            }
+            residual_fn(block, start, residuals);
+            pack_block(residuals, bits, packed);
+            packed += bits;
+        }
+        return total;
+    }
+
+    template <typename T, typename Fn>
+    static bool unpack(const char* in, const size_t in_size, T* out, const size_t count, Fn&& restore_fn) {
+        if (in_size < HEADER_SIZE) {
+            return false;
+        }
+        uint64_t base;
+        uint64_t bits;
+        memcpy(&base, in, sizeof(uint64_t));
+        memcpy(&bits, in + sizeof(uint64_t), sizeof(uint64_t));
+        const size_t blocks = (count + BLOCK_ELEMENTS - 1) / BLOCK_ELEMENTS;
+        if (bits > 64 || in_size != HEADER_SIZE + blocks * bits * sizeof(uint64_t)) {
+            return false;
+        }
+
+        const uint64_t* packed = reinterpret_cast<const uint64_t*>(in + HEADER_SIZE);
+        uint64_t residuals[BLOCK_ELEMENTS];
+        for (size_t b = 0; b < blocks; ++b) {
+            const size_t start = b * BLOCK_ELEMENTS;
+            const size_t n = (count - start < BLOCK_ELEMENTS) ? count - start : BLOCK_ELEMENTS;
+            unpack_block(packed, bits, residuals);
+            base = restore_fn(base, residuals, out + start, n);
+            packed += bits;
+        }
+        return true;
+    }
+
+    static inline void pack_block(const uint64_t* in, const uint64_t bits, uint64_t* out) {
+        memset(out, 0, bits * sizeof(uint64_t));
+        if (bits == 0) return;
+        for (size_t j = 0; j < BLOCK_ELEMENTS; ++j) {
+            const size_t bit = j * bits;
+            const size_t word = bit >> 6;
+            const size_t shift = bit & 63;
+            out[word] |= in[j] << shift;
+            if (shift + bits > 64) {
+                out[word + 1] |= in[j] >> (64 - shift);
+            }
+        }
+    }
+
+    static inline void unpack_block(const uint64_t* in, const uint64_t bits, uint64_t* out) {
+        if (bits == 0) {
+            memset(out, 0, BLOCK_ELEMENTS * sizeof(uint64_t));
+            return;
+        }
+        if (bits == 64) {
+            memcpy(out, in, BLOCK_ELEMENTS * sizeof(uint64_t));
+            return;
+        }
+        const uint64_t mask = (1ull << bits) - 1;
+#pragma omp simd
+        for (size_t j = 0; j < BLOCK_ELEMENTS; ++j) {
+            const size_t bit = j * bits;
+            const size_t word = bit >> 6;
+            const size_t shift = bit & 63;
+            uint64_t v = in[word] >> shift;
+            if (shift + bits > 64) {
+                v |= in[word + 1] << (64 - shift);
+            }
+            out[j] = v & mask;
+        }
+    }
+};
@@ -1,16 +1,30 @@
 #pragma once
 
+#include <array>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <random>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
+#include "ColumnDirectory.hpp"
+#include "Compression.hpp"
 #include "ConnectionManager.h"
+#include "DataGenerator.hpp"
+#include "FairQueue.hpp"
+#include "Transport.h"
 
 enum class catalog_communication_code : uint8_t {
     send_column_info = 0xA0,
@@ -27,7 +41,12 @@ enum class catalog_communication_code : uint8_t {
     generate_benchmark_data,
     ack_generate_benchmark_data,
     clear_catalog,
-    ack_clear_catalog
+    ack_clear_catalog,
+    announce_direct_region,
+    receive_column_ready,
+    fetch_column_batch,
+    fetch_table,
+    generate_ssb_data
 };
 
 enum class col_data_t : unsigned char {
@@ -74,6 +93,21 @@ struct col_network_info {
         }
     }
 
+    static size_t col_data_type_width(col_data_t info) {
+        switch (info) {
+            case col_data_t::gen_float:
+                return sizeof(float);
+            case col_data_t::gen_double:
+                return sizeof(double);
+            case col_data_t::gen_smallint:
+                return sizeof(uint8_t);
+            case col_data_t::gen_bigint:
+                return sizeof(uint64_t);
+            default:
+                return 0;
+        }
+    }
+
     static std::string col_data_type_to_string(col_data_t info) {
         switch (info) {
             case col_data_t::gen_float:
@@ -121,59 +155,298 @@ struct col_network_info {
 struct col_t;
 struct table_t;
 
+// Priority class of the query a request belongs to, requests of higher classes overtake queued requests of lower ones
+enum class request_priority_t : uint8_t {
+    interactive,
+    normal,
+    bulk
+};
+
+constexpr size_t PRIORITY_CLASSES = 3;
+
+inline std::string request_priority_to_string(request_priority_t priority) {
+    switch (priority) {
+        case request_priority_t::interactive:
+            return "interactive";
+        case request_priority_t::normal:
+            return "normal";
+        case request_priority_t::bulk:
+            return "bulk";
+        default:
+            return "unknown";
+    }
+}
+
+// Requests and queueing delay of one priority class, kept on both sides of a connection
+struct priority_stats_t {
+    size_t requests = 0;
+    size_t bytes = 0;
+    size_t queued = 0;
+    std::chrono::duration<double> queue_wait = std::chrono::duration<double>::zero();
+    std::chrono::duration<double> max_queue_wait = std::chrono::duration<double>::zero();
+
+    void record_wait(const std::chrono::duration<double> wait) {
+        ++queued;
+        queue_wait += wait;
+        if (wait > max_queue_wait) {
+            max_queue_wait = wait;
+        }
+    }
+};
+
+// Consumer side: a chunk request waiting for the window of its connection
+struct queued_request_t {
+    std::string ident;
+    bool whole_column;
+    size_t chunk_size;
+    size_t chunk_offset;
+    request_priority_t priority;
+    std::chrono::_V2::system_clock::time_point enqueued;
+};
+
+// Provider side: a requested column range (or another send, see custom) waiting for a sender thread
+struct send_job_t {
+    std::size_t conId;
+    std::string ident;
+    col_handle_t column_id;
+    bool whole_column;
+    size_t chunk_size;
+    size_t chunk_offset;
+    request_priority_t priority;
+    std::chrono::_V2::system_clock::time_point enqueued;
+    size_t cost = 0;                 // Bytes the job is expected to send, set when queued
+    std::function<void()> custom{};  // Sends something else than a column range, e.g. a pseudo PAX message
+};
+
+/* Wire format of a column range request, fetch_column_data and fetch_column_chunk carry one, fetch_column_batch several.
+ * The column is named by the id its provider announced with the column info.
+ */
+struct column_request_t {
+    uint64_t chunk_size;
+    uint64_t chunk_offset;
+    col_handle_t column_id;
+    request_priority_t priority;
+    bool whole_column;
+};
+
+/* App meta data of every column range message, see DataCatalog::sendColumnRange.
+ * chunk_offset/chunk_size describe the requested range inside the column, block_offset/block_size the (uncompressed) part
+ * of that range contained in this message.
+ */
+struct column_range_header_t {
+    uint64_t chunk_offset;
+    uint64_t chunk_size;
+    uint64_t block_offset;
+    uint64_t block_size;
+    col_handle_t column_id;
+    chunk_codec_t codec;
+    col_data_t data_type;
+};
+
+// Consumer side transfer statistics of a single connection
+struct connection_stats_t {
+    size_t requests = 0;
+    size_t requested_bytes = 0;
+    size_t sent_bytes = 0;  // Requested bytes whose request left the queue
+    size_t received_bytes = 0;
+    std::chrono::_V2::system_clock::time_point first_receive;
+    std::chrono::_V2::system_clock::time_point last_receive;
+
+    size_t outstanding_bytes() const {
+        return (requested_bytes > received_bytes) ? requested_bytes - received_bytes : 0;
+    }
+
+    size_t inflight_bytes() const {
+        return (sent_bytes > received_bytes) ? sent_bytes - received_bytes : 0;
+    }
+
+    // GiB/s between the first and the last received message
+    double throughput() const {
+        const std::chrono::duration<double> secs = last_receive - first_receive;
+        return (secs.count() > 0) ? (static_cast<double>(received_bytes) / 1024 / 1024 / 1024) / secs.count() : 0;
+    }
+};
+
+// Load of a provider summed over its connections, used to pick the replica a request is routed to
+struct provider_load_t {
+    size_t outstanding_bytes = 0;
+    double throughput = 0;  // GiB/s
+
+    // Seconds until all outstanding bytes arrived at the measured throughput
+    double drain_time() const {
+        return (throughput > 0) ? (static_cast<double>(outstanding_bytes) / 1024 / 1024 / 1024) / throughput : 0;
+    }
+};
+
+// Consumer side: a column announced by a provider, found by the column id in the messages of that provider
+struct remote_column_ref_t {
+    std::string ident;
+    col_handle_t handle = INVALID_COL_HANDLE;  // Handle of ident in the remote column directory
+    col_network_info* info = nullptr;          // Entry of remote_col_info, nullptr while the provider does not hold the column
+};
+
+// A data provider (memory node) reachable over one or more connections, the first connection carries the metadata traffic
+struct provider_info_t {
+    std::vector<std::size_t> connections;
+    uint64_t catalog_version = 0;  // Last applied version of the provider's catalog, 0 if unknown
+    bool catalog_subscribed = false;
+    // Announced columns indexed by the provider's column id, and the id of each ident for requests
+    std::vector<remote_column_ref_t> columns{};
+    std::unordered_map<std::string, col_handle_t> column_ids{};
+};
+
+enum class catalog_change_kind_t : uint8_t {
+    added,
+    removed
+};
+
+// Consumer side: schema of a table announced by a provider, its columns are regular remote columns of that provider
+struct remote_table_t {
+    std::string ident;
+    size_t numRows;
+    size_t keyColumn;  // Index of the primary key column in columns
+    bool isFactTable;
+    std::vector<std::string> columns;
+    std::size_t provider;
+};
+
+// One entry of the provider's catalog journal, version is the catalog version after applying the change
+struct catalog_change_t {
+    uint64_t version;
+    catalog_change_kind_t kind;
+    std::string ident;
+    col_network_info info;
+    col_handle_t column_id = INVALID_COL_HANDLE;
+};
+
 struct inflight_col_info_t {
     col_t* col;
     std::size_t curr_offset;
 };
 
+// A prepared PAX message, rows [row_offset, row_offset + row_cnt) of all columns stored consecutively in staging slot 'slot'
+struct pax_chunk_t {
+    size_t slot;
+    size_t payload_size;
+    size_t row_offset;
+    size_t row_cnt;
+};
+
+/* The preparing thread stages at most PAX_RING_SIZE messages ahead of the sender.
+ * Slots are handed back to free_slots once sendData copied them out, so provider memory is bounded by the ring and not the table.
+ */
+/* Staging state of a pseudo PAX stream. A preparing thread fills the ring slots, the sender threads send them.
+ * Sends are only queued for prepared messages, so a sender never waits for the preparation.
+ * A stream serves one kind of request (pulled messages or table streams) of one connection, see DataCatalog::streamPseudoPax.
+ */
 struct pax_inflight_col_info_t {
+    static const size_t PAX_RING_SIZE = 4;
+
+    std::string ident;
+    // Connection the stream is sent to, messages are sized for its transport
+    std::size_t conId = 0;
     std::vector<col_t*> cols;
-    std::queue<std::pair<size_t, size_t> > prepared_offsets;
+    std::queue<pax_chunk_t> prepared_offsets;
+    std::queue<size_t> free_slots;
+    std::vector<char*> ring_bufs;
     std::mutex offset_lock;
     std::thread* prepare_thread = nullptr;
-    std::condition_variable offset_cv;
+    std::condition_variable slot_cv;
     size_t metadata_size = 0;
     bool prepare_triggered = false;
     bool prepare_complete = false;
+    bool prepare_aborted = false;
     char* metadata_buf = nullptr;
-    char* payload_buf = nullptr;
+    // Priorities of requested messages that are not prepared yet, prepared messages no send was queued for, and sends in progress
+    std::queue<request_priority_t> waiting_sends;
+    size_t unclaimed = 0;
+    size_t sending = 0;
+
+    void release_slot(const size_t slot) {
+        {
+            std::lock_guard<std::mutex> lk(offset_lock);
+            free_slots.push(slot);
+        }
+        slot_cv.notify_one();
+    }
+
+    /* Ends the pass once every prepared message was sent. Requests still waiting are kept for the next pass,
+     * otherwise the staging state is freed and the next request starts a new pass.
+     * Expects offset_lock to be held and returns the finished preparing thread, which the caller joins without the lock.
+     */
+    std::thread* end_pass() {
+        if (!prepare_complete || !prepared_offsets.empty() || sending > 0) {
+            return nullptr;
+        }
+        std::thread* finished = prepare_thread;
+        prepare_thread = nullptr;
+        if (waiting_sends.empty()) {
+            clear_state();
+        } else {
+            prepare_triggered = false;
+            prepare_complete = false;
+        }
+        return finished;
+    }
 
     void reset() {
-        std::lock_guard<std::mutex> lk(offset_lock);
-        std::queue<std::pair<size_t, size_t> > empty;
-        prepared_offsets.swap(empty);
-        if (metadata_buf) delete metadata_buf;
-        metadata_buf = nullptr;
-        if (payload_buf) delete payload_buf;
-        payload_buf = nullptr;
+        {
+            std::lock_guard<std::mutex> lk(offset_lock);
+            prepare_aborted = true;
+        }
+        slot_cv.notify_all();
+        // Join without holding the lock, the preparing thread needs it to finish
         if (prepare_thread) {
             prepare_thread->join();
             delete prepare_thread;
+            prepare_thread = nullptr;
         }
-        prepare_triggered = false;
-        prepare_complete = false;
-        metadata_size = 0;
+
+        std::lock_guard<std::mutex> lk(offset_lock);
+        clear_state();
     }
 
     ~pax_inflight_col_info_t() {
         reset();
     }
+
+   private:
+    // Expects offset_lock to be held and no preparing thread to run
+    void clear_state() {
+        std::queue<pax_chunk_t> empty;
+        prepared_offsets.swap(empty);
+        std::queue<size_t> empty_slots;
+        free_slots.swap(empty_slots);
+        std::queue<request_priority_t> empty_sends;
+        waiting_sends.swap(empty_sends);
+        if (metadata_buf) free(metadata_buf);
+        metadata_buf = nullptr;
+        for (auto buf : ring_bufs) {
+            free(buf);
+        }
+        ring_bufs.clear();
+        unclaimed = 0;
+        prepare_triggered = false;
+        prepare_complete = false;
+        prepare_aborted = false;
+        metadata_size = 0;
+    }
 };
 
-typedef std::unordered_map<std::string, col_t*> col_dict_t;
 typedef std::unordered_map<std::string, col_network_info> col_remote_dict_t;
 typedef std::unordered_map<std::string, inflight_col_info_t> incomplete_transimssions_dict_t;
 typedef std::unordered_map<std::string, pax_inflight_col_info_t*> incomplete_pax_transimssions_dict_t;
 
 class DataCatalog {
    private:
-    col_dict_t cols;
-    col_dict_t remote_cols;
+    ColumnDirectory cols;
+    ColumnDirectory remote_cols;
     col_remote_dict_t remote_col_info;
-    bool col_info_received = false;
-    bool reconfigured = false;
-    bool dataGenerationDone = false;
-    bool clearCatalogDone = false;
+    size_t pending_info_replies = 0;
+    // Acks still expected from the providers for the last control message of each kind, see controlConnections
+    size_t pending_reconfigure_acks = 0;
+    size_t pending_generation_acks = 0;
+    size_t pending_clear_acks = 0;
     mutable std::mutex remote_info_lock;
     mutable std::mutex reconfigure_lock;
     mutable std::mutex appendLock;
@@ -189,13 +462,96 @@ class DataCatalog {
     incomplete_transimssions_dict_t inflight_cols;
     incomplete_pax_transimssions_dict_t pax_inflight_cols;
 
+    // Destination regions announced by consumers for direct writes, keyed by column ident
+    std::unordered_map<std::string, direct_region_t> direct_regions;
+    mutable std::mutex directRegionLock;
+
+    /* Provider side: version of the local catalog and the changes since catalog_journal_start.
+     * The journal keeps the latest CATALOG_JOURNAL_LIMIT changes, consumers knowing an older version get the full catalog.
+     */
+    static const size_t CATALOG_JOURNAL_LIMIT = 4096;
+    uint64_t catalog_version = 1;
+    uint64_t catalog_journal_start = 1;
+    std::deque<catalog_change_t> catalog_journal;
+    std::vector<std::size_t> catalog_subscribers;
+    mutable std::mutex catalogVersionLock;
+
+    // Consumer side: per connection statistics used to stripe requests
+    std::map<std::size_t, connection_stats_t> connection_stats;
+    size_t next_connection = 0;
+    // Requests held back while their connection has dataCatalog_requestWindow bytes in flight, and statistics per priority class
+    std::map<std::size_t, WeightedFairQueue<queued_request_t>> request_queues;
+    std::array<priority_stats_t, PRIORITY_CLASSES> request_priority_stats;
+    mutable std::mutex connectionStatsLock;
+
+    // Consumer side: bytes requested but not yet consumed by a scan, and columns that skipped a request for lack of budget
+    size_t budget_in_use = 0;
+    std::vector<std::pair<col_t*, bool>> budget_waiters;
+    // Parked columns releaseBudget is requesting for right now, forgetBudget waits until its column is not among them
+    std::vector<col_t*> budget_dispatching;
+    std::condition_variable budget_dispatch_cv;
+    mutable std::mutex budgetLock;
+
+    /* Provider side: send jobs per requesting connection, ordered by priority inside a requester.
+     * Sender threads serve the backlogged requesters by deficit round robin, a requester is served by one sender at a time.
+     * send_tails holds the last queued chunk job per requester and column, adjacent requests are merged into it.
+     */
+    std::map<std::size_t, WeightedFairQueue<std::shared_ptr<send_job_t>>> send_queues;
+    std::deque<std::size_t> active_requesters;
+    std::unordered_map<std::size_t, size_t> send_deficit;
+    std::unordered_map<std::size_t, bool> requester_busy;
+    std::map<std::pair<std::size_t, std::string>, std::shared_ptr<send_job_t>> send_tails;
+    std::array<priority_stats_t, PRIORITY_CLASSES> send_priority_stats;
+    size_t coalesced_requests = 0;
+    std::vector<std::thread> sender_threads;
+    bool senders_running = false;
+    std::condition_variable send_queue_cv;
+    mutable std::mutex sendQueueLock;
+
+    // Consumer side: known providers keyed by their primary connection and the providers holding each remote column
+    std::map<std::size_t, provider_info_t> providers{{1, provider_info_t{{1}}}};
+    std::unordered_map<std::size_t, std::size_t> connection_provider{{1, 1}};
+    std::unordered_map<std::string, std::vector<std::size_t>> column_placement;
+    mutable std::mutex placementLock;
+
+    // Consumer side: tables announced by the providers, guarded by remote_info_lock
+    std::map<std::string, remote_table_t> remote_tables;
+
+    // Consumer side: remote columns replaced by a republished shape. Readers may still hold them, so they are only freed by clear and eraseAllRemoteColumns
+    std::vector<col_t*> retired_cols;
+    mutable std::mutex retiredLock;
+
     DataCatalog();
 
    public:
     uint64_t dataCatalog_chunkMaxSize = 1024 * 512 * 4;
     uint64_t dataCatalog_chunkThreshold = 1024 * 512 * 4;
+    bool dataCatalog_compression = false;
+    bool dataCatalog_adaptiveChunking = false;
+    bool dataCatalog_directReceive = false;
+    bool dataCatalog_catalogPush = false;
+    // Maximum number of chunk requests in flight per column and replica
+    size_t dataCatalog_stripeWidth = 1;
+    // Bytes in flight per connection before further requests are queued by priority, 0 sends every request immediately
+    size_t dataCatalog_requestWindow = 0;
+    // Share of the bandwidth per priority class while several classes are backlogged, indexed by request_priority_t
+    std::array<double, PRIORITY_CLASSES> dataCatalog_priorityWeights{8, 4, 1};
+    // Bytes that may be requested but not yet consumed across all remote columns, 0 does not limit requests
+    size_t dataCatalog_receiveBudget = 0;
+    // Provider side: threads sending requested data, and the largest range adjacent chunk requests are merged into
+    size_t dataCatalog_senderThreads = 2;
+    size_t dataCatalog_coalesceLimit = 1024 * 1024 * 64;
+    // Bytes a PrefetchPlanner keeps requested ahead of its consumers, 0 derives the distance from latency and bandwidth
+    size_t dataCatalog_prefetchLookahead = 0;
+    // Upper bound of a derived lookahead
+    size_t dataCatalog_prefetchLimit = 1024 * 1024 * 64;
+    DirectWriteTransport* directWriteTransport = nullptr;
+    // Local tables, tables added with add_table are announced with the catalog
     std::map<std::string, table_t*> tables;
 
+    // Chunk offset of requests that leave the position to the provider's per column cursor
+    static constexpr size_t NEXT_CHUNK_OFFSET = std::numeric_limits<size_t>::max();
+
     static DataCatalog& getInstance();
 
     DataCatalog(DataCatalog const&) = delete;
@@ -204,30 +560,91 @@ class DataCatalog {
 
     void clear(bool sendRemot = false, bool destructor = false);
 
-    void registerCallback(uint8_t code, CallbackFunction cb) const;
-
-    col_dict_t::iterator generate(std::string ident, col_data_t type, size_t elemCount, int node);
-    col_t* find_local(std::string ident) const;
-    col_t* find_remote(std::string ident) const;
+    // Registers cb with the RDMA and the shared memory transport, cb takes the receive buffer type as auto
+    template <typename Callback>
+    void registerCallback(uint8_t code, Callback cb) const;
+
+    col_t* generate(std::string ident, col_data_t type, size_t elemCount, int node);
+    // Correlated columns draw from the local column source, which must be complete and of the same type
+    col_t* generate(std::string ident, col_data_t type, size_t elemCount, int node, const gen_spec_t& spec, const std::string& source = "");
+    col_t* find_local(const std::string& ident) const;
+    col_t* find_remote(const std::string& ident) const;
+    // Interned idents for lookups from worker threads, a handle resolves without hashing or locking
+    col_handle_t local_handle(const std::string& ident);
+    col_handle_t remote_handle(const std::string& ident);
+    col_t* resolve_local(col_handle_t handle) const;
+    col_t* resolve_remote(col_handle_t handle) const;
     col_t* add_column(std::string ident, col_t* col);
+    col_t* remove_column(const std::string& ident);
     col_t* add_remote_column(std::string name, col_network_info ni);
+    bool add_table(table_t* table);
+    bool has_table(const std::string& ident) const;
+    bool find_remote_table(const std::string& ident, remote_table_t& table) const;
 
     void remoteInfoReady();
-    void fetchRemoteInfo();
+    void fetchRemoteInfo(bool force = false);
     void print_column(std::string& ident) const;
     void print_all() const;
     void print_all_remotes() const;
 
     std::vector<std::string> getLocalColumnNames() const;
     std::vector<std::string> getRemoteColumnNames() const;
+    std::vector<std::string> getRemoteTableNames() const;
 
     void eraseAllRemoteColumns();
 
+    void addProvider(const std::vector<std::size_t>& connections);
+    void connectProvider(std::size_t conId);
+    std::vector<std::size_t> getProviders(const std::string& ident) const;
+    std::vector<std::size_t> controlConnections() const;
+    std::size_t scheduleConnection(const std::string& ident, const size_t bytes);
+    std::size_t maxPayloadSize(std::size_t conId, std::size_t appMetaSize) const;
+    void submitRequest(std::size_t conId, std::string& ident, bool whole_column, size_t chunk_size, size_t chunk_offset, request_priority_t priority);
+    bool acquireBudget(col_t* col, const size_t bytes, bool fetch_complete_column);
+    void releaseBudget(const size_t bytes);
+    void forgetBudget(col_t* col, const size_t held_bytes);
+    void print_connection_stats() const;
+
     void reconfigureChunkSize(const uint64_t newChunkSize, const uint64_t newChunkThreshold);
 
-    void generateBenchmarkData(const uint64_t distinctLocalColumns, const uint64_t remoteColumnsForLocal, const uint64_t localColumnElements, const uint64_t percentageOfRemote, const uint64_t localNumaNode = 0, const uint64_t remoteNumaNode = 0, bool sendToRemote = false, bool createTables = false);
+    void generateBenchmarkData(const uint64_t distinctLocalColumns, const uint64_t remoteColumnsForLocal, const uint64_t localColumnElements, const uint64_t percentageOfRemote, const uint64_t localNumaNode = 0, const uint64_t remoteNumaNode = 0, bool sendToRemote = false, bool createTables = false, const gen_spec_t& spec = {});
+
+    // Generates the SSB tables on this node or, with sendToRemote, on the provider only and waits for its acknowledgement
+    void generateSSBData(const double scaleFactor, const uint64_t numaNode = 0, bool sendToRemote = false);
 
     // Communication stubs
-    void fetchColStub(std::size_t conId, std::string& ident, bool whole_column = true) const;
+    void fetchColStub(std::size_t conId, std::string& ident, bool whole_column = true, size_t chunk_size = 0, size_t chunk_offset = NEXT_CHUNK_OFFSET, request_priority_t priority = request_priority_t::normal) const;
+    void fetchColBatchStub(const std::vector<col_t*>& columns, bool whole_column = false);
     void fetchPseudoPax(std::size_t conId, std::vector<std::string> idents) const;
+    std::vector<col_t*> fetchTable(const std::string& ident, const std::vector<std::string>& columns = {}, request_priority_t priority = request_priority_t::normal);
+    void announceDirectRegion(col_t* col) const;
+
+   private:
+    void sendColumnRange(std::size_t conId, const col_t* col, const std::string& ident, col_handle_t column_id, const size_t offset, const size_t size, catalog_communication_code code) const;
+    void sendNextColumnChunk(std::size_t conId, const std::string& ident, col_handle_t column_id, const size_t requested_chunk_size, const size_t requested_offset);
+    void streamPseudoPax(std::size_t conId, const std::vector<std::string>& idents, bool whole, request_priority_t priority = request_priority_t::normal);
+    void preparePseudoPax(pax_inflight_col_info_t* info);
+    void sendPreparedPax(pax_inflight_col_info_t* info);
+    void enqueuePaxSend(pax_inflight_col_info_t* info, request_priority_t priority);
+    bool makeSendJob(std::size_t conId, const column_request_t& request, std::chrono::_V2::system_clock::time_point enqueued, send_job_t& job) const;
+    const remote_column_ref_t* resolveColumnId(std::size_t conId, col_handle_t column_id) const;
+    col_handle_t columnIdOf(std::size_t conId, const std::string& ident) const;
+    template <typename Buffer>
+    bool receiveColumnMessage(std::size_t conId, const Buffer* rcv_buffer);
+    template <typename Buffer>
+    bool receiveColumnReady(std::size_t conId, const Buffer* rcv_buffer);
+    void accountReceived(std::size_t conId, const size_t bytes);
+    void releaseQueuedRequests(std::size_t conId);
+    void enqueueSend(send_job_t job);
+    std::shared_ptr<send_job_t> popSendJob();
+    void executeSendJob(const send_job_t& job);
+    void runSender();
+    void startSenders();
+    void stopSenders();
+    void recordCatalogChange(catalog_change_kind_t kind, const std::string& ident, const col_t* col);
+    void sendCatalogDelta(std::size_t conId, uint64_t known_version, bool is_push) const;
+    std::size_t providerOf(std::size_t conId) const;
+    void completeColumnRange(col_t* col, col_network_info& network_info, const size_t chunk_offset, const size_t chunk_size, const size_t received_bytes);
+    void retireColumn(col_t* col);
+    void freeRetiredColumns();
 };
\ No newline at end of file
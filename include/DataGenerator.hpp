@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+enum class gen_distribution_t : uint8_t {
+    uniform = 0,
+    zipf,        // value lower + k with probability ~ 1 / (k + 1)^zipf_theta, small values are hot
+    sorted,      // uniform values in ascending order
+    clustered,   // runs of cluster_rows rows drawn around a random center
+    correlated   // the value of a source column with probability correlation, uniform otherwise
+};
+
+/* Shape of a generated column. Bounds are inclusive and stored as double, so integer bounds are exact up to 2^53.
+ * Values of one (seed, stream) pair are identical for any thread count and any split of the rows.
+ */
+struct gen_spec_t {
+    gen_distribution_t distribution = gen_distribution_t::uniform;
+    double lower = 0;
+    double upper = 100;
+    double zipf_theta = 0.99;  // in [0, 1), higher is more skewed
+    uint64_t cluster_rows = 4096;
+    double cluster_spread = 0.01;  // width of a cluster as fraction of [lower, upper]
+    double correlation = 0.9;
+    uint32_t seed = 0;
+};
+
+/* Counter-based parallel generator on Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3").
+ * Random draw r of row i only depends on (seed, stream, i, r), so rows are filled independently by an omp loop.
+ */
+class DataGenerator {
+   public:
+    static std::string distribution_to_string(gen_distribution_t distribution) {
+        switch (distribution) {
+            case gen_distribution_t::uniform:
+                return "uniform";
+            case gen_distribution_t::zipf:
+                return "zipf";
+            case gen_distribution_t::sorted:
+                return "sorted";
+            case gen_distribution_t::clustered:
+                return "clustered";
+            case gen_distribution_t::correlated:
+                return "correlated";
+            default:
+                return "Distribution case not implemented!";
+        }
+    }
+
+    static std::array<uint32_t, 4> philox(std::array<uint32_t, 4> ctr, std::array<uint32_t, 2> key) {
+        for (size_t round = 0; round < 10; ++round) {
+            const uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * ctr[0];
+            const uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * ctr[2];
+            ctr = {static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0], static_cast<uint32_t>(p1), static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1], static_cast<uint32_t>(p0)};
+            key[0] += PHILOX_W0;
+            key[1] += PHILOX_W1;
+        }
+        return ctr;
+    }
+
+    // Two independent 64bit draws for row of the given stream
+    static std::array<uint64_t, 2> draw(const uint32_t seed, const uint32_t stream, const uint64_t row, const uint32_t sequence = 0) {
+        const auto r = philox({static_cast<uint32_t>(row), static_cast<uint32_t>(row >> 32), sequence, 0}, {seed, stream});
+        return {(static_cast<uint64_t>(r[0]) << 32) | r[1], (static_cast<uint64_t>(r[2]) << 32) | r[3]};
+    }
+
+    // Uniform in [0, 1)
+    static double unit(const uint64_t bits) {
+        return (bits >> 11) * 0x1.0p-53;
+    }
+
+    /* Fills data[0, count) according to spec. source must hold count values for correlated columns.
+     * Returns false if the spec cannot be generated, data is left untouched then.
+     */
+    template <typename T>
+    static bool fill(T* data, const size_t count, const gen_spec_t& spec, const uint32_t stream, const T* source = nullptr) {
+        if (spec.upper < spec.lower || (spec.distribution == gen_distribution_t::correlated && source == nullptr)) {
+            return false;
+        }
+
+        // Integer draws are continuous in [lower, upper + 1) and rounded down, so upper is as likely as any other value
+        const double span = spec.upper - spec.lower + (std::is_integral<T>::value ? 1 : 0);
+        const zipf_t zipf = (spec.distribution == gen_distribution_t::zipf) ? zipf_t(static_cast<uint64_t>(spec.upper - spec.lower) + 1, spec.zipf_theta) : zipf_t();
+        const double cluster_width = span * std::clamp(spec.cluster_spread, 0.0, 1.0);
+        const uint64_t cluster_rows = std::max<uint64_t>(spec.cluster_rows, 1);
+
+#pragma omp parallel for schedule(static)
+        for (size_t i = 0; i < count; ++i) {
+            const auto r = draw(spec.seed, stream, i);
+            double value;
+            switch (spec.distribution) {
+                case gen_distribution_t::zipf: {
+                    data[i] = static_cast<T>(spec.lower + zipf.rank(unit(r[0])));
+                    continue;
+                }
+                case gen_distribution_t::sorted: {
+                    // Row i draws from the i-th of count equal slices, so the column is ascending without a sort
+                    value = spec.lower + span * ((i + unit(r[0])) / count);
+                    break;
+                }
+                case gen_distribution_t::clustered: {
+                    const double center = spec.lower + (span - cluster_width) * unit(draw(spec.seed, stream, i / cluster_rows, 1)[0]);
+                    value = center + cluster_width * unit(r[0]);
+                    break;
+                }
+                case gen_distribution_t::correlated: {
+                    if (unit(r[1]) < spec.correlation) {
+                        data[i] = std::clamp(source[i], static_cast<T>(spec.lower), static_cast<T>(spec.upper));
+                        continue;
+                    }
+                    value = spec.lower + span * unit(r[0]);
+                    break;
+                }
+                default: {
+                    value = spec.lower + span * unit(r[0]);
+                    break;
+                }
+            }
+            data[i] = convert<T>(value, spec.upper);
+        }
+        return true;
+    }
+
+   private:
+    static constexpr uint32_t PHILOX_M0 = 0xD2511F53;
+    static constexpr uint32_t PHILOX_M1 = 0xCD9E8D57;
+    static constexpr uint32_t PHILOX_W0 = 0x9E3779B9;
+    static constexpr uint32_t PHILOX_W1 = 0xBB67AE85;
+    static constexpr uint64_t EXACT_ZETA_TERMS = 1 << 20;
+
+    template <typename T>
+    static T convert(const double value, const double upper) {
+        if constexpr (std::is_integral<T>::value) {
+            return static_cast<T>(std::min(std::floor(value), upper));
+        } else {
+            return static_cast<T>(value);
+        }
+    }
+
+    /* Zipf ranks by inversion as in Gray et al., "Quickly Generating Billion-Record Synthetic Databases".
+     * zeta(n) is summed exactly for the first EXACT_ZETA_TERMS ranks and integrated beyond, so setup stays cheap for large domains.
+     */
+    struct zipf_t {
+        uint64_t n = 1;
+        double theta = 0;
+        double alpha = 1;
+        double zetan = 1;
+        double eta = 0;
+        double half_pow_theta = 1;
+
+        zipf_t() = default;
+
+        zipf_t(const uint64_t domain, const double skew) : n{std::max<uint64_t>(domain, 1)}, theta{std::clamp(skew, 0.0, 0.9999)} {
+            alpha = 1 / (1 - theta);
+            zetan = zeta(n, theta);
+            half_pow_theta = std::pow(0.5, theta);
+            const double zeta2 = zeta(std::min<uint64_t>(n, 2), theta);
+            eta = (n > 2) ? (1 - std::pow(2.0 / n, 1 - theta)) / (1 - zeta2 / zetan) : 0;
+        }
+
+        static double zeta(const uint64_t n, const double theta) {
+            const uint64_t exact = std::min(n, EXACT_ZETA_TERMS);
+            double sum = 0;
+            for (uint64_t i = 1; i <= exact; ++i) {
+                sum += 1 / std::pow(static_cast<double>(i), theta);
+            }
+            if (n > exact) {
+                sum += (std::pow(n + 0.5, 1 - theta) - std::pow(exact + 0.5, 1 - theta)) / (1 - theta);
+            }
+            return sum;
+        }
+
+        // Zero based rank, 0 is the most frequent
+        uint64_t rank(const double u) const {
+            const double uz = u * zetan;
+            if (n == 1 || uz < 1) {
+                return 0;
+            }
+            if (n == 2 || uz < 1 + half_pow_theta) {
+                return 1;
+            }
+            return std::min<uint64_t>(static_cast<uint64_t>(n * std::pow(eta * u - eta + 1, alpha)), n - 1);
+        }
+    };
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+/* Weighted fair queue over a fixed number of classes (self-clocked fair queueing).
+ * Every item is tagged with a virtual finish time of max(virtual time, last finish of its class) + cost / weight,
+ * items are dequeued in tag order. A class with twice the weight gets about twice the bytes while all classes are backlogged,
+ * an idle class does not accumulate credit.
+ * Not thread-safe, the owner guards it with its own lock.
+ */
+template <typename T>
+class WeightedFairQueue {
+   public:
+    explicit WeightedFairQueue(const size_t class_count = 1) : last_finish(class_count, 0) {}
+
+    void push(const size_t cls, const size_t cost, const double weight, T item) {
+        if (cls >= last_finish.size()) {
+            last_finish.resize(cls + 1, 0);
+        }
+        const double start = std::max(virtual_time, last_finish[cls]);
+        const double finish = start + static_cast<double>(cost) / (weight > 0 ? weight : 1);
+        last_finish[cls] = finish;
+        entries.push(entry_t{finish, next_sequence++, std::move(item)});
+    }
+
+    // Expects the queue to be non-empty
+    T pop() {
+        entry_t top = std::move(const_cast<entry_t&>(entries.top()));
+        entries.pop();
+        virtual_time = top.finish;
+        return std::move(top.item);
+    }
+
+    const T& top() const {
+        return entries.top().item;
+    }
+
+    bool empty() const {
+        return entries.empty();
+    }
+
+    size_t size() const {
+        return entries.size();
+    }
+
+   private:
+    struct entry_t {
+        double finish;
+        uint64_t sequence;  // Keeps FIFO order between equal tags
+        T item;
+
+        bool operator>(const entry_t& other) const {
+            return (finish != other.finish) ? finish > other.finish : sequence > other.sequence;
+        }
+    };
+
+    std::priority_queue<entry_t, std::vector<entry_t>, std::greater<entry_t>> entries;
+    std::vector<double> last_finish;
+    double virtual_time = 0;
+    uint64_t next_sequence = 0;
+};
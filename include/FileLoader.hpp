@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "DataCatalog.h"
+
+struct col_t;
+struct table_t;
+
+struct csv_options_t {
+    char delimiter = ',';
+    bool header = true;             // names the columns, otherwise they are called <table>_col_<i> like in table_t
+    std::vector<col_data_t> types;  // one per column, empty loads every column of the first row as uint64_t
+    int node = 0;                   // NUMA node of the column buffers
+};
+
+/* Loads files into new catalog columns.
+ * The file is mmapped and cut into ranges on line boundaries. A first parallel pass counts the rows of every range, a second
+ * one parses each range straight into its rows of the NUMA placed column buffers. Only numeric fields without quotes are
+ * supported, unparsable fields are loaded as 0 and reported.
+ */
+class FileLoader {
+   public:
+    // Adds the table and its columns to the catalog, nullptr if the file cannot be read or an ident is taken
+    static table_t* loadCsv(const std::string& path, const std::string& table, const csv_options_t& options = {});
+
+    // Adds a column holding the file as raw array of type values (native byte order, e.g. written by numpy's tofile)
+    static col_t* loadBinary(const std::string& path, const std::string& ident, col_data_t type, int node = 0);
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Logger.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+
+/* A message (package) received over a non-RDMA transport.
+ * The fields mirror the package header of the RDMA transport, a message larger than maxBytesInPayload arrives as several packages.
+ * payload and meta are only valid until the callback returns.
+ */
+struct transport_message_t {
+    uint8_t code;
+    char* payload;
+    char* meta;
+    uint64_t meta_size;
+    uint64_t message_id;
+    uint64_t total_data_size;
+    uint64_t payload_size;
+    uint64_t package_number;
+    uint64_t payload_position_offset;
+};
+
+/* Send/receive contract of the catalog, modelled after ConnectionManager.
+ * sendData copies (or finished transmitting) data and meta before returning, payloads larger than maxBytesInPayload
+ * are split into packages that all carry the meta data. Callbacks are registered once per code and shared by all connections.
+ */
+class MessageTransport {
+   public:
+    using callback_t = std::function<void(const size_t, const transport_message_t&)>;
+
+    virtual ~MessageTransport() = default;
+
+    virtual bool hasChannel(const size_t conId) const = 0;
+    virtual size_t maxBytesInPayload(const size_t conId, const size_t metaSize) const = 0;
+    virtual int sendData(const size_t conId, char* data, const size_t size, char* meta, const size_t metaSize, const uint8_t code) = 0;
+    virtual void closeChannel(const size_t conId) = 0;
+    virtual void stop() = 0;
+    virtual std::string name() const = 0;
+
+    int sendOpCode(const size_t conId, const uint8_t code) {
+        return sendData(conId, nullptr, 0, nullptr, 0, code);
+    }
+
+    bool registerCallback(const uint8_t code, callback_t cb) {
+        std::unique_lock<std::shared_mutex> lk(callbackLock);
+        if (callbacks[code]) {
+            return false;
+        }
+        callbacks[code] = std::move(cb);
+        return true;
+    }
+
+   protected:
+    void dispatch(const size_t conId, const transport_message_t& message) {
+        std::shared_lock<std::shared_mutex> lk(callbackLock);
+        if (callbacks[message.code]) {
+            callbacks[message.code](conId, message);
+        } else {
+            LOG_WARNING("[" << name() << "] No callback for code " << static_cast<uint64_t>(message.code) << " on connection " << conId << std::endl;)
+        }
+    }
+
+   private:
+    std::array<callback_t, 256> callbacks;
+    std::shared_mutex callbackLock;
+};
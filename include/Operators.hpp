@@ -4,6 +4,8 @@
 
 #include <vector>
 
+#include "SimdSelection.hpp"
+
 class Operators {
    public:
     template <bool isFirst = false>
@@ -152,4 +154,12 @@ class Operators {
 
         return out_vec;
     }
+
+    // Vectorized isFirst variant for all column types, predicate_2 is only used by the between operators
+    template <typename T>
+    static inline std::vector<size_t> select(const compare_op_t op, const T* data, const T predicate_1, const T predicate_2, const size_t blockSize) {
+        std::vector<size_t> out_vec(blockSize + SimdSelection::OUTPUT_SLACK);
+        out_vec.resize(SimdSelection::select(op, data, blockSize, predicate_1, predicate_2, out_vec.data()));
+        return out_vec;
+    }
 };
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Column.h"
+#include "RangeFuture.hpp"
+
+/* Small pool of worker threads running morsel coroutines.
+ * A morsel co_awaits data_ready(...) for the column ranges it touches. If a range is not resident yet, the morsel is suspended
+ * and the worker picks up the next runnable morsel instead of blocking in iterator_data_available.wait. Once the range arrived,
+ * the receiving thread only re-queues the morsel, it is resumed by one of the workers.
+ *     PipelineExecutor executor(4);
+ *     executor.spawn(morsel(executor, ...));
+ *     executor.wait_all();
+ */
+class PipelineExecutor {
+   public:
+    struct morsel_task_t {
+        struct promise_type {
+            PipelineExecutor* executor = nullptr;
+
+            morsel_task_t get_return_object() {
+                return morsel_task_t{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+            std::suspend_always initial_suspend() noexcept {
+                return {};
+            }
+            // The frame is destroyed when the morsel finishes, the executor only keeps track of the number of running morsels
+            std::suspend_never final_suspend() noexcept {
+                return {};
+            }
+            void return_void() {
+                executor->task_done();
+            }
+            void unhandled_exception() {
+                LOG_ERROR("[PipelineExecutor] Morsel terminated with an exception." << std::endl;)
+                executor->task_done();
+            }
+        };
+
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    // Suspends the morsel until [offset, offset + size) bytes of col are readable and resumes it on a worker
+    struct data_ready_t {
+        PipelineExecutor* executor;
+        RangeFuture future;
+
+        bool await_ready() const {
+            return future.is_ready();
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) const {
+            // The morsel may be resumed on another worker before then() returns, only locals are used from here on
+            PipelineExecutor* pool = executor;
+            RangeFuture pending = future;
+            pending.then([pool, handle](bool) { pool->post(handle); });
+        }
+
+        bool await_resume() const {
+            return future.wait();
+        }
+    };
+
+    // Moves the morsel to the back of the run queue
+    struct yield_t {
+        PipelineExecutor* executor;
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+        void await_suspend(std::coroutine_handle<> handle) const {
+            executor->post(handle);
+        }
+        void await_resume() const noexcept {}
+    };
+
+    explicit PipelineExecutor(const size_t worker_count) {
+        workers.reserve(worker_count);
+        for (size_t i = 0; i < worker_count; ++i) {
+            workers.emplace_back([this] { run(); });
+        }
+    }
+
+    PipelineExecutor(PipelineExecutor const&) = delete;
+    void operator=(PipelineExecutor const&) = delete;
+
+    ~PipelineExecutor() {
+        wait_all();
+        {
+            std::lock_guard<std::mutex> lk(queueLock);
+            running = false;
+        }
+        queue_cv.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    void spawn(morsel_task_t task) {
+        task.handle.promise().executor = this;
+        {
+            std::lock_guard<std::mutex> lk(queueLock);
+            ++pending_tasks;
+        }
+        post(task.handle);
+    }
+
+    // Blocks the calling (non-worker) thread until all spawned morsels finished
+    void wait_all() {
+        std::unique_lock<std::mutex> lk(queueLock);
+        done_cv.wait(lk, [this] { return pending_tasks == 0; });
+    }
+
+    data_ready_t data_ready(col_t* col, const size_t offset, const size_t size, const bool fetch_complete_column = false) {
+        return data_ready_t{this, col->request_range(offset, size, fetch_complete_column)};
+    }
+
+    yield_t yield() {
+        return yield_t{this};
+    }
+
+    void post(std::coroutine_handle<> handle) {
+        {
+            std::lock_guard<std::mutex> lk(queueLock);
+            run_queue.push_back(handle);
+        }
+        queue_cv.notify_one();
+    }
+
+   private:
+    void task_done() {
+        std::lock_guard<std::mutex> lk(queueLock);
+        if (--pending_tasks == 0) {
+            done_cv.notify_all();
+        }
+    }
+
+    void run() {
+        for (;;) {
+            std::coroutine_handle<> handle;
+            {
+                std::unique_lock<std::mutex> lk(queueLock);
+                queue_cv.wait(lk, [this] { return !run_queue.empty() || !running; });
+                if (run_queue.empty()) {
+                    return;
+                }
+                handle = run_queue.front();
+                run_queue.pop_front();
+            }
+            handle.resume();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::deque<std::coroutine_handle<>> run_queue;
+    size_t pending_tasks = 0;
+    bool running = true;
+    std::mutex queueLock;
+    std::condition_variable queue_cv;
+    std::condition_variable done_cv;
+};
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Column.h"
+#include "DataCatalog.h"
+#include "RangeFuture.hpp"
+
+// One step of a pipeline: the bytes [offset, offset + size) of col are read
+struct prefetch_access_t {
+    col_t* col;
+    size_t offset;
+    size_t size;
+};
+
+/* Requests the column ranges of a query plan ahead of the pipelines reading them.
+ * The planner gets the ordered accesses of one or more pipelines. acquire(i) blocks until access i is resident and issues
+ * the following accesses as long as the bytes issued but not yet released stay within the lookahead.
+ * With DataCatalog::dataCatalog_prefetchLookahead == 0 the lookahead is derived from measurements: twice the bytes arriving
+ * during one request latency at the slower of receive bandwidth and consumption rate. A derived lookahead is bounded by
+ * dataCatalog_prefetchLimit and half the receive budget, so prefetched data is still cache resident when the pipeline
+ * reaches it and does not hold the budget of other columns.
+ *     PrefetchPlanner planner(accesses);
+ *     planner.acquire(i);  ...  planner.release(i);
+ * acquire and release may be called from several workers, accesses are always issued in plan order.
+ */
+class PrefetchPlanner {
+   public:
+    explicit PrefetchPlanner(std::vector<prefetch_access_t> plan, const bool fetch_complete_column = false)
+        : accesses{std::move(plan)}, futures(accesses.size()), fetch_complete_column{fetch_complete_column}, measurements{std::make_shared<measurements_t>()} {}
+
+    PrefetchPlanner(PrefetchPlanner const&) = delete;
+    void operator=(PrefetchPlanner const&) = delete;
+
+    // Returns false if the range will never become resident, e.g. because its column was erased
+    bool acquire(const size_t index) {
+        {
+            std::lock_guard<std::mutex> lk(plannerLock);
+            if (!started) {
+                start = std::chrono::high_resolution_clock::now();
+                started = true;
+            }
+        }
+        issue(index + 1);
+
+        RangeFuture future;
+        {
+            std::unique_lock<std::mutex> lk(plannerLock);
+            issued_cv.wait(lk, [this, index] { return futures[index].valid(); });
+            future = futures[index];
+        }
+        return future.wait();
+    }
+
+    // The pipeline is done with access index, its bytes leave the lookahead window and give their receive budget back
+    void release(const size_t index) {
+        {
+            std::lock_guard<std::mutex> lk(plannerLock);
+            outstanding_bytes -= accesses[index].size;
+            released_bytes += accesses[index].size;
+        }
+        accesses[index].col->consume(accesses[index].size);
+        issue(0);
+    }
+
+    size_t lookahead_bytes() const {
+        std::lock_guard<std::mutex> lk(plannerLock);
+        return lookahead();
+    }
+
+   private:
+    // Shared with the continuations of issued futures, which may complete after the planner is gone
+    struct measurements_t {
+        std::mutex lock;
+        double latency = 0;  // Seconds from issuing a range until it is resident, exponentially smoothed
+        size_t samples = 0;
+        size_t pending = 0;  // Issued ranges that were not resident yet
+        size_t completed_bytes = 0;
+        std::chrono::time_point<std::chrono::high_resolution_clock> busy_since;
+        std::chrono::duration<double> busy_time{0};
+    };
+
+    static constexpr double LATENCY_SMOOTHING = 0.2;
+    static constexpr double JITTER_FACTOR = 2.0;
+
+    // Expects plannerLock to be held
+    size_t lookahead() const {
+        DataCatalog& catalog = DataCatalog::getInstance();
+        if (catalog.dataCatalog_prefetchLookahead) {
+            return catalog.dataCatalog_prefetchLookahead;
+        }
+
+        size_t limit = catalog.dataCatalog_prefetchLimit;
+        if (catalog.dataCatalog_receiveBudget) {
+            limit = std::min(limit, catalog.dataCatalog_receiveBudget / 2);
+        }
+        const size_t minimum = std::min<size_t>(catalog.dataCatalog_chunkMaxSize, limit);
+
+        double latency;
+        double bandwidth;
+        {
+            std::lock_guard<std::mutex> lk(measurements->lock);
+            if (measurements->samples == 0) {
+                return std::min<size_t>(catalog.dataCatalog_chunkMaxSize * catalog.dataCatalog_stripeWidth, limit);
+            }
+            latency = measurements->latency;
+            auto busy = measurements->busy_time;
+            if (measurements->pending > 0) {
+                busy += std::chrono::high_resolution_clock::now() - measurements->busy_since;
+            }
+            bandwidth = (busy.count() > 0) ? measurements->completed_bytes / busy.count() : 0;
+        }
+
+        double rate = bandwidth;
+        const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+        if (released_bytes > 0 && elapsed.count() > 0) {
+            rate = std::min(rate, released_bytes / elapsed.count());
+        }
+        const size_t derived = static_cast<size_t>(JITTER_FACTOR * latency * rate);
+        return std::clamp(derived, minimum, limit);
+    }
+
+    /* Issues accesses in plan order: all accesses before force_until, then as many as fit into the lookahead.
+     * Accesses are reserved under plannerLock but requested without it, continuations of resident ranges run inline.
+     */
+    void issue(const size_t force_until) {
+        std::vector<size_t> reserved;
+        {
+            std::lock_guard<std::mutex> lk(plannerLock);
+            const size_t window = lookahead();
+            while (next_issue < accesses.size() && (next_issue < force_until || outstanding_bytes == 0 || outstanding_bytes + accesses[next_issue].size <= window)) {
+                outstanding_bytes += accesses[next_issue].size;
+                reserved.push_back(next_issue++);
+            }
+        }
+
+        for (auto index : reserved) {
+            const prefetch_access_t& access = accesses[index];
+            const auto issued = std::chrono::high_resolution_clock::now();
+            RangeFuture future = access.col->request_range(access.offset, access.size, fetch_complete_column);
+            if (!future.is_ready()) {
+                std::shared_ptr<measurements_t> stats = measurements;
+                {
+                    std::lock_guard<std::mutex> lk(stats->lock);
+                    if (stats->pending++ == 0) {
+                        stats->busy_since = issued;
+                    }
+                }
+                const size_t bytes = access.size;
+                future.then([stats, issued, bytes](bool) {
+                    const auto now = std::chrono::high_resolution_clock::now();
+                    const std::chrono::duration<double> latency = now - issued;
+                    std::lock_guard<std::mutex> lk(stats->lock);
+                    stats->latency = (stats->samples++ == 0) ? latency.count() : (1 - LATENCY_SMOOTHING) * stats->latency + LATENCY_SMOOTHING * latency.count();
+                    stats->completed_bytes += bytes;
+                    if (--stats->pending == 0) {
+                        stats->busy_time += now - stats->busy_since;
+                    }
+                });
+            }
+
+            {
+                std::lock_guard<std::mutex> lk(plannerLock);
+                futures[index] = std::move(future);
+            }
+            issued_cv.notify_all();
+        }
+    }
+
+    const std::vector<prefetch_access_t> accesses;
+    std::vector<RangeFuture> futures;
+    const bool fetch_complete_column;
+    std::shared_ptr<measurements_t> measurements;
+
+    size_t next_issue = 0;
+    size_t outstanding_bytes = 0;
+    size_t released_bytes = 0;
+    bool started = false;
+    std::chrono::time_point<std::chrono::high_resolution_clock> start;
+    mutable std::mutex plannerLock;
+    std::condition_variable issued_cv;
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/* Handle for a requested column range that completes once the range is resident.
+ * The result is true if the data is readable and false if the column went away before the range arrived.
+ * A future can be waited on (blocking), continued with a callback or awaited from a C++20 coroutine:
+ *     auto fut = col->request_range(0, col->sizeInBytes);
+ *     fut.then([](bool resident) { ... });
+ *     bool resident = co_await fut;
+ * Continuations run on the thread completing the range (usually a receive callback) or inline if the range is already resident,
+ * they must not block and should hand longer work to an executor.
+ */
+class RangeFuture {
+   public:
+    struct state_t {
+        std::mutex lock;
+        std::condition_variable cv;
+        bool done = false;
+        bool resident = false;
+        std::vector<std::function<void(bool)>> continuations;
+    };
+
+    RangeFuture() = default;
+    explicit RangeFuture(std::shared_ptr<state_t> state) : state{std::move(state)} {}
+
+    static void complete(const std::shared_ptr<state_t>& state, const bool resident) {
+        std::vector<std::function<void(bool)>> continuations;
+        {
+            std::lock_guard<std::mutex> lk(state->lock);
+            if (state->done) {
+                return;
+            }
+            state->done = true;
+            state->resident = resident;
+            continuations.swap(state->continuations);
+        }
+        state->cv.notify_all();
+        for (auto& continuation : continuations) {
+            continuation(resident);
+        }
+    }
+
+    bool valid() const {
+        return state != nullptr;
+    }
+
+    bool is_ready() const {
+        std::lock_guard<std::mutex> lk(state->lock);
+        return state->done;
+    }
+
+    bool wait() const {
+        std::unique_lock<std::mutex> lk(state->lock);
+        state->cv.wait(lk, [this] { return state->done; });
+        return state->resident;
+    }
+
+    // Returns false on timeout as well as for ranges that will never become resident
+    template <typename Rep, typename Period>
+    bool wait_for(const std::chrono::duration<Rep, Period>& timeout) const {
+        std::unique_lock<std::mutex> lk(state->lock);
+        return state->cv.wait_for(lk, timeout, [this] { return state->done; }) && state->resident;
+    }
+
+    void then(std::function<void(bool)> continuation) const {
+        std::unique_lock<std::mutex> lk(state->lock);
+        if (!state->done) {
+            state->continuations.push_back(std::move(continuation));
+            return;
+        }
+        const bool resident = state->resident;
+        lk.unlock();
+        continuation(resident);
+    }
+
+    struct awaiter_t {
+        std::shared_ptr<state_t> state;
+
+        bool await_ready() const {
+            std::lock_guard<std::mutex> lk(state->lock);
+            return state->done;
+        }
+
+        // Does not suspend if the range completed between await_ready and here
+        bool await_suspend(std::coroutine_handle<> handle) const {
+            std::lock_guard<std::mutex> lk(state->lock);
+            if (state->done) {
+                return false;
+            }
+            state->continuations.push_back([handle](bool) { handle.resume(); });
+            return true;
+        }
+
+        bool await_resume() const {
+            std::lock_guard<std::mutex> lk(state->lock);
+            return state->resident;
+        }
+    };
+
+    awaiter_t operator co_await() const {
+        return awaiter_t{state};
+    }
+
+   private:
+    std::shared_ptr<state_t> state;
+};
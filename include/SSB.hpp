@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+
+// Where the columns of an SSB run are read from
+enum class ssb_mode_t : uint8_t {
+    local,  // local catalog, tables on the worker's NUMA node
+    numa,   // local catalog, tables generated on another NUMA node
+    remote  // remote columns of the provider, fetched while the query runs
+};
+
+// Aggregate per group, the key holds the grouping attributes in the order of the query's dimensions (0 if not grouped)
+struct ssb_result_t {
+    std::map<std::array<uint64_t, 4>, int64_t> groups;
+    size_t rows = 0;   // lineorder rows passing all filters
+    size_t bytes = 0;  // column bytes read by the query
+    bool valid = true;
+};
+
+/* Star Schema Benchmark (O'Neil et al.) on uint64_t columns.
+ * generate creates lineorder, date, customer, supplier and part as table_t and announces them like all other tables.
+ * String attributes are dictionary encoded so that the SSB constants keep their digits:
+ *     region 0..4 (AFRICA, AMERICA, ASIA, EUROPE, MIDDLE EAST), nation 0..24 in TPC-H order, city = nation * 10 + digit,
+ *     'MFGR#1' = 1, 'MFGR#12' = 12, 'MFGR#1221' = 1221, d_yearmonth 'Dec1997' = d_yearmonthnum 199712.
+ * Only the columns used by the 13 queries are generated.
+ */
+class SSB {
+   public:
+    static const size_t QUERY_COUNT = 13;
+
+    static std::string mode_to_string(ssb_mode_t mode);
+    static std::string query_name(size_t query);
+    static std::string result_to_string(const ssb_result_t& result);
+
+    // Adds the SSB tables at scaleFactor to the local catalog, columns are allocated on node
+    static void generate(double scaleFactor, int node);
+
+    // Runs query (0 = Q1.1 ... 12 = Q4.3) with workers threads scanning lineorder blockwise
+    static ssb_result_t execute(size_t query, ssb_mode_t mode, size_t workers);
+};
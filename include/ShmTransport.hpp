@@ -0,0 +1,430 @@
+#pragma once
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+
+#include "MessageTransport.hpp"
+
+/* Message transport for provider and consumer running on the same host, e.g. on different sockets.
+ * A channel is a named POSIX shared memory segment holding two single-producer ring buffers, one per direction.
+ * Records are copied into the ring by the sender and handed to the registered callback in place on the receiving side.
+ * Both sides sleep on futex doorbells in the segment when the ring is empty (receiver) or full (sender),
+ * a doorbell is only rung if the other side announced that it is about to sleep.
+ *     ShmTransport::getInstance().openChannel(1, "provider0", true);   // provider process
+ *     ShmTransport::getInstance().openChannel(1, "provider0", false);  // consumer process
+ * Every channel has a single receive thread, callbacks run in order and must not wait for messages of the same channel.
+ */
+class ShmTransport : public MessageTransport {
+   public:
+    static constexpr size_t DEFAULT_RING_CAPACITY = 64ull * 1024 * 1024;
+
+    static ShmTransport& getInstance() {
+        static ShmTransport instance;
+        return instance;
+    }
+
+    ShmTransport(ShmTransport const&) = delete;
+    void operator=(ShmTransport const&) = delete;
+
+    ~ShmTransport() override {
+        stop();
+    }
+
+    // The creating side sizes and initializes the segment, the attaching side must open the same name afterwards
+    bool openChannel(const size_t conId, const std::string& name, const bool create, const size_t ring_capacity = DEFAULT_RING_CAPACITY) {
+        if (hasChannel(conId)) {
+            LOG_WARNING("[ShmTransport] Connection " << conId << " is already a shared memory channel." << std::endl;)
+            return false;
+        }
+
+        const std::string shm_name = "/" + name;
+        const int fd = shm_open(shm_name.c_str(), create ? (O_CREAT | O_EXCL | O_RDWR) : O_RDWR, 0600);
+        if (fd < 0) {
+            LOG_ERROR("[ShmTransport] Could not open shared memory segment " << shm_name << ": " << strerror(errno) << std::endl;)
+            return false;
+        }
+
+        uint64_t capacity = MIN_RING_CAPACITY;
+        while (capacity < ring_capacity) {
+            capacity <<= 1;
+        }
+
+        size_t mapped_size;
+        if (create) {
+            mapped_size = SEGMENT_HEADER_SIZE + 2 * capacity;
+            if (ftruncate(fd, mapped_size) != 0) {
+                LOG_ERROR("[ShmTransport] Could not size shared memory segment " << shm_name << ": " << strerror(errno) << std::endl;)
+                close(fd);
+                shm_unlink(shm_name.c_str());
+                return false;
+            }
+        } else {
+            struct stat info;
+            if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < SEGMENT_HEADER_SIZE) {
+                LOG_ERROR("[ShmTransport] Shared memory segment " << shm_name << " is not initialized." << std::endl;)
+                close(fd);
+                return false;
+            }
+            mapped_size = info.st_size;
+        }
+
+        void* base = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+            LOG_ERROR("[ShmTransport] Could not map shared memory segment " << shm_name << ": " << strerror(errno) << std::endl;)
+            if (create) {
+                shm_unlink(shm_name.c_str());
+            }
+            return false;
+        }
+
+        auto channel = std::make_shared<channel_t>();
+        channel->conId = conId;
+        channel->name = shm_name;
+        channel->owner = create;
+        channel->base = reinterpret_cast<char*>(base);
+        channel->mapped_size = mapped_size;
+
+        if (create) {
+            channel->header = new (base) segment_header_t();
+            channel->header->ring_capacity = capacity;
+            channel->header->magic.store(SEGMENT_MAGIC, std::memory_order_release);
+        } else {
+            channel->header = reinterpret_cast<segment_header_t*>(base);
+            if (channel->header->magic.load(std::memory_order_acquire) != SEGMENT_MAGIC || SEGMENT_HEADER_SIZE + 2 * channel->header->ring_capacity != mapped_size) {
+                LOG_ERROR("[ShmTransport] Shared memory segment " << shm_name << " has an unexpected layout." << std::endl;)
+                return false;
+            }
+            capacity = channel->header->ring_capacity;
+            channel->header->attached.store(1);
+        }
+
+        // Ring 0 carries messages from the creating to the attaching process
+        channel->capacity = capacity;
+        const size_t send_ring = create ? 0 : 1;
+        channel->send_ring = &channel->header->rings[send_ring];
+        channel->send_data = channel->base + SEGMENT_HEADER_SIZE + send_ring * capacity;
+        channel->receive_ring = &channel->header->rings[1 - send_ring];
+        channel->receive_data = channel->base + SEGMENT_HEADER_SIZE + (1 - send_ring) * capacity;
+        channel->receiver = std::thread([this, ch = channel.get()] { receive(ch); });
+
+        {
+            std::unique_lock<std::shared_mutex> lk(channelLock);
+            channels[conId] = channel;
+        }
+
+        LOG_INFO("[ShmTransport] Connection " << conId << " " << (create ? "created" : "attached to") << " " << shm_name << " with " << capacity << " Bytes per direction" << std::endl;)
+        return true;
+    }
+
+    // Must not be called from a callback of the channel itself
+    void closeChannel(const size_t conId) override {
+        std::shared_ptr<channel_t> channel;
+        {
+            std::unique_lock<std::shared_mutex> lk(channelLock);
+            auto it = channels.find(conId);
+            if (it == channels.end()) {
+                return;
+            }
+            channel = it->second;
+            channels.erase(it);
+        }
+        shutdown(*channel);
+        LOG_INFO("[ShmTransport] Closed shared memory channel of connection " << conId << std::endl;)
+    }
+
+    bool hasChannel(const size_t conId) const override {
+        std::shared_lock<std::shared_mutex> lk(channelLock);
+        return channels.find(conId) != channels.end();
+    }
+
+    // A record never exceeds a quarter of the ring, so a sender always makes progress once the receiver drained the ring
+    size_t maxBytesInPayload(const size_t conId, const size_t metaSize) const override {
+        auto channel = getChannel(conId);
+        if (!channel) {
+            return 0;
+        }
+        const size_t overhead = RECORD_HEADER_SIZE + align(metaSize);
+        return (channel->capacity / 4 > overhead) ? channel->capacity / 4 - overhead : 0;
+    }
+
+    int sendData(const size_t conId, char* data, const size_t size, char* meta, const size_t metaSize, const uint8_t code) override {
+        auto channel = getChannel(conId);
+        if (!channel) {
+            LOG_ERROR("[ShmTransport] No shared memory channel for connection " << conId << std::endl;)
+            return 1;
+        }
+        const size_t max_payload = maxBytesInPayload(conId, metaSize);
+        if (max_payload == 0) {
+            LOG_ERROR("[ShmTransport] Meta data of " << metaSize << " Bytes does not fit into a record of connection " << conId << std::endl;)
+            return 1;
+        }
+
+        std::lock_guard<std::mutex> lk(channel->sendLock);
+        record_t record{};
+        record.message_id = channel->next_message_id++;
+        record.total_data_size = size;
+        record.meta_size = metaSize;
+        record.code = code;
+
+        size_t offset = 0;
+        do {
+            record.payload_size = std::min(max_payload, size - offset);
+            record.payload_position_offset = offset;
+            if (!publish(*channel, record, meta, data + offset)) {
+                LOG_ERROR("[ShmTransport] Connection " << conId << " closed while sending." << std::endl;)
+                return 1;
+            }
+            ++record.package_number;
+            offset += record.payload_size;
+        } while (offset < size);
+
+        return 0;
+    }
+
+    void stop() override {
+        std::map<size_t, std::shared_ptr<channel_t>> closing;
+        {
+            std::unique_lock<std::shared_mutex> lk(channelLock);
+            closing.swap(channels);
+        }
+        for (auto& channel : closing) {
+            shutdown(*channel.second);
+        }
+    }
+
+    std::string name() const override {
+        return "ShmTransport";
+    }
+
+   private:
+    static constexpr uint64_t SEGMENT_MAGIC = 0x4D454D4F53484D31;  // "MEMOSHM1"
+    static constexpr uint64_t MIN_RING_CAPACITY = 1024 * 1024;
+    static constexpr size_t RECORD_ALIGNMENT = 64;
+    static constexpr size_t RECORD_HEADER_SIZE = 64;
+    static constexpr size_t SPIN_ROUNDS = 4096;
+    // Sleepers wake up periodically to notice a closed channel
+    static constexpr long DOORBELL_TIMEOUT_NS = 100 * 1000 * 1000;
+
+    struct ring_t {
+        alignas(64) std::atomic<uint64_t> head{0};  // Bytes published by the sender
+        alignas(64) std::atomic<uint64_t> tail{0};  // Bytes released by the receiver
+        alignas(64) std::atomic<uint32_t> data_doorbell{0};
+        std::atomic<uint32_t> receiver_sleeping{0};
+        alignas(64) std::atomic<uint32_t> space_doorbell{0};
+        std::atomic<uint32_t> sender_sleeping{0};
+    };
+
+    struct segment_header_t {
+        std::atomic<uint64_t> magic{0};
+        uint64_t ring_capacity = 0;
+        std::atomic<uint32_t> attached{0};
+        std::atomic<uint32_t> closed{0};
+        ring_t rings[2];
+    };
+
+    static constexpr size_t SEGMENT_HEADER_SIZE = (sizeof(segment_header_t) + 4095) & ~size_t{4095};
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free, "Shared memory rings need address-free atomics");
+
+    // Record layout in the ring: [ record_t | meta, padded to RECORD_ALIGNMENT | payload | padding ]
+    struct record_t {
+        uint64_t size;  // Whole record including padding
+        uint64_t message_id;
+        uint64_t total_data_size;
+        uint64_t payload_size;
+        uint64_t package_number;
+        uint64_t payload_position_offset;
+        uint32_t meta_size;
+        uint8_t code;
+        bool skip;  // Fills the end of the ring if the next record does not fit in before the wrap around
+    };
+
+    static_assert(sizeof(record_t) <= RECORD_HEADER_SIZE, "Record header exceeds its reserved space");
+
+    struct channel_t {
+        size_t conId;
+        std::string name;
+        bool owner;
+        char* base = nullptr;
+        size_t mapped_size = 0;
+        segment_header_t* header = nullptr;
+        uint64_t capacity = 0;
+        ring_t* send_ring = nullptr;
+        char* send_data = nullptr;
+        ring_t* receive_ring = nullptr;
+        char* receive_data = nullptr;
+
+        std::mutex sendLock;
+        uint64_t next_message_id = 0;
+        std::atomic<bool> running{true};
+        std::thread receiver;
+
+        ~channel_t() {
+            if (base) {
+                munmap(base, mapped_size);
+            }
+            if (owner) {
+                shm_unlink(name.c_str());
+            }
+        }
+    };
+
+    ShmTransport() = default;
+
+    static size_t align(const size_t bytes) {
+        return (bytes + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+    }
+
+    // Shared (not process private) futex operations, the doorbells are rung across process boundaries
+    static void doorbell_wait(std::atomic<uint32_t>* doorbell, const uint32_t seen) {
+        timespec timeout{0, DOORBELL_TIMEOUT_NS};
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(doorbell), FUTEX_WAIT, seen, &timeout, nullptr, 0);
+    }
+
+    static void doorbell_ring(std::atomic<uint32_t>* doorbell) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(doorbell), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+
+    std::shared_ptr<channel_t> getChannel(const size_t conId) const {
+        std::shared_lock<std::shared_mutex> lk(channelLock);
+        auto it = channels.find(conId);
+        return (it == channels.end()) ? nullptr : it->second;
+    }
+
+    static bool is_open(const channel_t& channel) {
+        return channel.running.load() && channel.header->closed.load() == 0;
+    }
+
+    void shutdown(channel_t& channel) {
+        channel.running = false;
+        channel.header->closed.store(1);
+        for (auto& ring : channel.header->rings) {
+            ring.data_doorbell.fetch_add(1);
+            doorbell_ring(&ring.data_doorbell);
+            ring.space_doorbell.fetch_add(1);
+            doorbell_ring(&ring.space_doorbell);
+        }
+        if (channel.receiver.joinable()) {
+            channel.receiver.join();
+        }
+    }
+
+    // Called with sendLock held, the sending process is the only writer of head
+    bool publish(channel_t& channel, const record_t& record, const char* meta, const char* payload) {
+        ring_t* ring = channel.send_ring;
+        const uint64_t mask = channel.capacity - 1;
+        const size_t meta_space = align(record.meta_size);
+        const uint64_t record_size = align(RECORD_HEADER_SIZE + meta_space + record.payload_size);
+
+        uint64_t head = ring->head.load(std::memory_order_relaxed);
+        const uint64_t contiguous = channel.capacity - (head & mask);
+        const uint64_t needed = (contiguous < record_size) ? contiguous + record_size : record_size;
+
+        while (channel.capacity - (head - ring->tail.load(std::memory_order_acquire)) < needed) {
+            if (!is_open(channel)) {
+                return false;
+            }
+            ring->sender_sleeping.store(1);
+            const uint32_t seen = ring->space_doorbell.load();
+            if (channel.capacity - (head - ring->tail.load(std::memory_order_acquire)) < needed) {
+                doorbell_wait(&ring->space_doorbell, seen);
+            }
+            ring->sender_sleeping.store(0);
+        }
+
+        if (contiguous < record_size) {
+            record_t* skip = reinterpret_cast<record_t*>(channel.send_data + (head & mask));
+            skip->size = contiguous;
+            skip->skip = true;
+            head += contiguous;
+        }
+
+        char* dst = channel.send_data + (head & mask);
+        record_t* out = reinterpret_cast<record_t*>(dst);
+        *out = record;
+        out->size = record_size;
+        out->skip = false;
+        if (record.meta_size) {
+            memcpy(dst + RECORD_HEADER_SIZE, meta, record.meta_size);
+        }
+        if (record.payload_size) {
+            memcpy(dst + RECORD_HEADER_SIZE + meta_space, payload, record.payload_size);
+        }
+
+        ring->head.store(head + record_size, std::memory_order_release);
+        ring->data_doorbell.fetch_add(1);
+        if (ring->receiver_sleeping.load()) {
+            doorbell_ring(&ring->data_doorbell);
+        }
+        return true;
+    }
+
+    // Spins shortly before going to sleep, returns as soon as a record is available or the wait timed out
+    static void wait_for_data(channel_t* channel, const uint64_t tail) {
+        ring_t* ring = channel->receive_ring;
+        for (size_t i = 0; i < SPIN_ROUNDS; ++i) {
+            if (ring->head.load(std::memory_order_acquire) != tail) {
+                return;
+            }
+        }
+        ring->receiver_sleeping.store(1);
+        const uint32_t seen = ring->data_doorbell.load();
+        if (ring->head.load(std::memory_order_acquire) == tail && is_open(*channel)) {
+            doorbell_wait(&ring->data_doorbell, seen);
+        }
+        ring->receiver_sleeping.store(0);
+    }
+
+    void receive(channel_t* channel) {
+        ring_t* ring = channel->receive_ring;
+        const uint64_t mask = channel->capacity - 1;
+        uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+
+        while (channel->running.load()) {
+            if (ring->head.load(std::memory_order_acquire) == tail) {
+                if (!is_open(*channel)) {
+                    break;
+                }
+                wait_for_data(channel, tail);
+                continue;
+            }
+
+            char* src = channel->receive_data + (tail & mask);
+            const record_t* record = reinterpret_cast<const record_t*>(src);
+            if (!record->skip) {
+                transport_message_t message{record->code, src + RECORD_HEADER_SIZE + align(record->meta_size), src + RECORD_HEADER_SIZE, record->meta_size, record->message_id, record->total_data_size, record->payload_size, record->package_number, record->payload_position_offset};
+                dispatch(channel->conId, message);
+            }
+
+            // The record is released once the callback returned, callbacks copy whatever they keep
+            tail += record->size;
+            ring->tail.store(tail, std::memory_order_release);
+            ring->space_doorbell.fetch_add(1);
+            if (ring->sender_sleeping.load()) {
+                doorbell_ring(&ring->space_doorbell);
+            }
+        }
+    }
+
+    std::map<size_t, std::shared_ptr<channel_t>> channels;
+    mutable std::shared_mutex channelLock;
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+enum class compare_op_t : uint8_t {
+    less_than,
+    less_equal,
+    greater_than,
+    greater_equal,
+    equal,
+    between_incl,  // predicate_1 <= value <= predicate_2
+    between_excl   // predicate_1 < value < predicate_2
+};
+
+enum class simd_level_t : uint8_t {
+    scalar,
+    avx2,    // lookup table based position emission
+    avx512   // compress based position emission, needs AVX-512F and BW
+};
+
+/* Vectorized selection of the positions matching a predicate, the counterpart of the isFirst variants in Operators for all column types.
+ * The kernel is picked at runtime from the instruction sets of the CPU, set_level can only lower it (e.g. for comparisons).
+ * Kernels store whole vectors of positions, so out has to hold count + OUTPUT_SLACK positions.
+ */
+class SimdSelection {
+   public:
+    static constexpr size_t OUTPUT_SLACK = 8;
+
+    static simd_level_t detected_level();
+    static simd_level_t level();
+    // Returns the level in use, which is at most the detected one
+    static simd_level_t set_level(simd_level_t level);
+
+    static std::string level_to_string(simd_level_t level);
+    static std::string op_to_string(compare_op_t op);
+
+    // Writes the positions i < count whose value matches to out in ascending order and returns their number
+    template <typename T>
+    static size_t select(compare_op_t op, const T* data, size_t count, T predicate_1, T predicate_2, size_t* out);
+};
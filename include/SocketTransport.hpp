@@ -0,0 +1,594 @@
+#pragma once
+
+#include <arpa/inet.h>
+#include <linux/io_uring.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MessageTransport.hpp"
+
+/* Message transport over TCP for nodes without an active InfiniBand port.
+ * Sends are submitted to a per connection io_uring: frame header and meta data are staged in a registered buffer,
+ * payloads of at least ZERO_COPY_THRESHOLD Bytes are sent with IORING_OP_SEND_ZC straight from column memory.
+ * sendData returns only after the kernel released the payload pages, so callers keep the copy semantics of ConnectionManager.
+ * Without io_uring (old kernel, seccomp) or SEND_ZC the same frames are written with sendmsg.
+ *     SocketTransport::getInstance().listen(1, 20000);               // provider
+ *     SocketTransport::getInstance().connect(1, "10.0.0.1", 20000);  // consumer
+ * Every connection has a single receive thread, callbacks run in order and must not wait for messages of the same connection.
+ */
+class SocketTransport : public MessageTransport {
+   public:
+    static constexpr size_t DEFAULT_PACKAGE_SIZE = 4 * 1024 * 1024;
+    // Pinning pages and waiting for the notification costs more than copying small payloads
+    static constexpr size_t ZERO_COPY_THRESHOLD = 64 * 1024;
+
+    static SocketTransport& getInstance() {
+        static SocketTransport instance;
+        return instance;
+    }
+
+    SocketTransport(SocketTransport const&) = delete;
+    void operator=(SocketTransport const&) = delete;
+
+    ~SocketTransport() override {
+        stop();
+    }
+
+    // Blocks until the peer connected
+    bool listen(const size_t conId, const uint16_t port) {
+        if (hasChannel(conId)) {
+            LOG_WARNING("[SocketTransport] Connection " << conId << " is already a socket connection." << std::endl;)
+            return false;
+        }
+
+        const int listener = socket(AF_INET6, SOCK_STREAM, 0);
+        if (listener < 0) {
+            LOG_ERROR("[SocketTransport] Could not create socket: " << strerror(errno) << std::endl;)
+            return false;
+        }
+        const int enable = 1;
+        const int disable = 0;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+        setsockopt(listener, IPPROTO_IPV6, IPV6_V6ONLY, &disable, sizeof(disable));
+
+        sockaddr_in6 address{};
+        address.sin6_family = AF_INET6;
+        address.sin6_addr = in6addr_any;
+        address.sin6_port = htons(port);
+        if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listener, 1) != 0) {
+            LOG_ERROR("[SocketTransport] Could not listen on port " << port << ": " << strerror(errno) << std::endl;)
+            close(listener);
+            return false;
+        }
+
+        LOG_INFO("[SocketTransport] Waiting for connection " << conId << " on port " << port << std::endl;)
+        const int fd = accept(listener, nullptr, nullptr);
+        close(listener);
+        if (fd < 0) {
+            LOG_ERROR("[SocketTransport] Accepting connection " << conId << " failed: " << strerror(errno) << std::endl;)
+            return false;
+        }
+        return addChannel(conId, fd);
+    }
+
+    // Retries for a few seconds, the listening side may be started a little later
+    bool connect(const size_t conId, const std::string& host, const uint16_t port) {
+        if (hasChannel(conId)) {
+            LOG_WARNING("[SocketTransport] Connection " << conId << " is already a socket connection." << std::endl;)
+            return false;
+        }
+
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* addresses = nullptr;
+        const std::string service = std::to_string(port);
+        if (getaddrinfo(host.c_str(), service.c_str(), &hints, &addresses) != 0) {
+            LOG_ERROR("[SocketTransport] Could not resolve " << host << std::endl;)
+            return false;
+        }
+
+        int fd = -1;
+        for (size_t attempt = 0; attempt < CONNECT_ATTEMPTS && fd < 0; ++attempt) {
+            for (addrinfo* it = addresses; it != nullptr; it = it->ai_next) {
+                fd = socket(it->ai_family, it->ai_socktype, it->ai_protocol);
+                if (fd < 0) {
+                    continue;
+                }
+                if (::connect(fd, it->ai_addr, it->ai_addrlen) == 0) {
+                    break;
+                }
+                close(fd);
+                fd = -1;
+            }
+            if (fd < 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+        }
+        freeaddrinfo(addresses);
+
+        if (fd < 0) {
+            LOG_ERROR("[SocketTransport] Could not connect to " << host << ":" << port << std::endl;)
+            return false;
+        }
+        return addChannel(conId, fd);
+    }
+
+    void closeChannel(const size_t conId) override {
+        std::shared_ptr<channel_t> channel;
+        {
+            std::unique_lock<std::shared_mutex> lk(channelLock);
+            auto it = channels.find(conId);
+            if (it == channels.end()) {
+                return;
+            }
+            channel = it->second;
+            channels.erase(it);
+        }
+        shutdownChannel(*channel);
+        LOG_INFO("[SocketTransport] Closed socket connection " << conId << std::endl;)
+    }
+
+    bool hasChannel(const size_t conId) const override {
+        std::shared_lock<std::shared_mutex> lk(channelLock);
+        return channels.find(conId) != channels.end();
+    }
+
+    // Socket frames carry the meta data next to the payload (see frame_t), so it does not take payload space
+    size_t maxBytesInPayload(const size_t conId, [[maybe_unused]] const size_t metaSize) const override {
+        return hasChannel(conId) ? DEFAULT_PACKAGE_SIZE : 0;
+    }
+
+    int sendData(const size_t conId, char* data, const size_t size, char* meta, const size_t metaSize, const uint8_t code) override {
+        auto channel = getChannel(conId);
+        if (!channel) {
+            LOG_ERROR("[SocketTransport] No socket connection " << conId << std::endl;)
+            return 1;
+        }
+        if (FRAME_HEADER_SIZE + metaSize > STAGING_SIZE) {
+            LOG_ERROR("[SocketTransport] Meta data of " << metaSize << " Bytes does not fit into a frame of connection " << conId << std::endl;)
+            return 1;
+        }
+
+        std::lock_guard<std::mutex> lk(channel->sendLock);
+        frame_t frame{};
+        frame.magic = FRAME_MAGIC;
+        frame.message_id = channel->next_message_id++;
+        frame.total_data_size = size;
+        frame.meta_size = metaSize;
+        frame.code = code;
+
+        size_t offset = 0;
+        do {
+            frame.payload_size = std::min(DEFAULT_PACKAGE_SIZE, size - offset);
+            frame.payload_position_offset = offset;
+            if (!sendFrame(*channel, frame, meta, data + offset)) {
+                LOG_ERROR("[SocketTransport] Sending on connection " << conId << " failed: " << strerror(errno) << std::endl;)
+                return 1;
+            }
+            ++frame.package_number;
+            offset += frame.payload_size;
+        } while (offset < size);
+
+        return 0;
+    }
+
+    void stop() override {
+        std::map<size_t, std::shared_ptr<channel_t>> closing;
+        {
+            std::unique_lock<std::shared_mutex> lk(channelLock);
+            closing.swap(channels);
+        }
+        for (auto& channel : closing) {
+            shutdownChannel(*channel.second);
+        }
+    }
+
+    std::string name() const override {
+        return "SocketTransport";
+    }
+
+   private:
+    static constexpr uint32_t FRAME_MAGIC = 0x4D454D4F;  // "MEMO"
+    static constexpr size_t FRAME_HEADER_SIZE = 64;
+    static constexpr size_t STAGING_SIZE = 128 * 1024;
+    static constexpr size_t CONNECT_ATTEMPTS = 50;
+    static constexpr unsigned URING_ENTRIES = 8;
+    static constexpr int SOCKET_BUFFER_SIZE = 8 * 1024 * 1024;
+
+    // Frame layout on the wire: [ frame_t, padded to FRAME_HEADER_SIZE | meta | payload ]
+    struct frame_t {
+        uint32_t magic;
+        uint32_t meta_size;
+        uint64_t message_id;
+        uint64_t total_data_size;
+        uint64_t payload_size;
+        uint64_t package_number;
+        uint64_t payload_position_offset;
+        uint8_t code;
+    };
+
+    static_assert(sizeof(frame_t) <= FRAME_HEADER_SIZE, "Frame header exceeds its reserved space");
+
+    /* Minimal io_uring submission/completion ring on top of the raw system calls.
+     * Only used by the sending thread of one connection, which holds the connection's sendLock.
+     */
+    class uring_t {
+       public:
+        ~uring_t() {
+            if (sqes) {
+                munmap(sqes, sqes_size);
+            }
+            if (cq_ptr && cq_ptr != sq_ptr) {
+                munmap(cq_ptr, cq_size);
+            }
+            if (sq_ptr) {
+                munmap(sq_ptr, sq_size);
+            }
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+
+        bool init(const unsigned entries) {
+            io_uring_params params{};
+            fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+            if (fd < 0) {
+                return false;
+            }
+
+            sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+            if (single_mmap) {
+                sq_size = cq_size = std::max(sq_size, cq_size);
+            }
+
+            sq_ptr = mapRing(sq_size, IORING_OFF_SQ_RING);
+            cq_ptr = single_mmap ? sq_ptr : mapRing(cq_size, IORING_OFF_CQ_RING);
+            sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+            sqes = reinterpret_cast<io_uring_sqe*>(mapRing(sqes_size, IORING_OFF_SQES));
+            if (!sq_ptr || !cq_ptr || !sqes) {
+                return false;
+            }
+
+            sq_tail = reinterpret_cast<unsigned*>(sq_ptr + params.sq_off.tail);
+            sq_mask = *reinterpret_cast<unsigned*>(sq_ptr + params.sq_off.ring_mask);
+            sq_array = reinterpret_cast<unsigned*>(sq_ptr + params.sq_off.array);
+            cq_head = reinterpret_cast<unsigned*>(cq_ptr + params.cq_off.head);
+            cq_tail = reinterpret_cast<unsigned*>(cq_ptr + params.cq_off.tail);
+            cq_mask = *reinterpret_cast<unsigned*>(cq_ptr + params.cq_off.ring_mask);
+            cqes = reinterpret_cast<io_uring_cqe*>(cq_ptr + params.cq_off.cqes);
+            local_tail = *sq_tail;
+            return true;
+        }
+
+        bool supports(const uint8_t opcode) const {
+            const size_t probe_size = sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op);
+            io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(calloc(1, probe_size));
+            bool supported = false;
+            if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, 256) == 0 && opcode <= probe->last_op) {
+                supported = probe->ops[opcode].flags & IO_URING_OP_SUPPORTED;
+            }
+            free(probe);
+            return supported;
+        }
+
+        bool registerBuffer(void* address, const size_t size) {
+            iovec buffer{address, size};
+            return syscall(__NR_io_uring_register, fd, IORING_REGISTER_BUFFERS, &buffer, 1) == 0;
+        }
+
+        io_uring_sqe* nextSqe() {
+            const unsigned index = local_tail & sq_mask;
+            io_uring_sqe* sqe = &sqes[index];
+            memset(sqe, 0, sizeof(io_uring_sqe));
+            sq_array[index] = index;
+            ++local_tail;
+            ++unsubmitted;
+            return sqe;
+        }
+
+        // Publishes all prepared entries and waits for at least wait_for completions
+        int enter(const unsigned wait_for) {
+            std::atomic_ref<unsigned>(*sq_tail).store(local_tail, std::memory_order_release);
+            const unsigned submit = unsubmitted;
+            unsubmitted = 0;
+            int ret;
+            do {
+                ret = static_cast<int>(syscall(__NR_io_uring_enter, fd, submit, wait_for, IORING_ENTER_GETEVENTS, nullptr, 0));
+            } while (ret < 0 && errno == EINTR);
+            return ret;
+        }
+
+        bool popCqe(io_uring_cqe& cqe) {
+            const unsigned head = std::atomic_ref<unsigned>(*cq_head).load(std::memory_order_relaxed);
+            if (head == std::atomic_ref<unsigned>(*cq_tail).load(std::memory_order_acquire)) {
+                return false;
+            }
+            cqe = cqes[head & cq_mask];
+            std::atomic_ref<unsigned>(*cq_head).store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+       private:
+        char* mapRing(const size_t size, const off_t offset) const {
+            void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+            return (ptr == MAP_FAILED) ? nullptr : reinterpret_cast<char*>(ptr);
+        }
+
+        int fd = -1;
+        char* sq_ptr = nullptr;
+        char* cq_ptr = nullptr;
+        size_t sq_size = 0;
+        size_t cq_size = 0;
+        io_uring_sqe* sqes = nullptr;
+        size_t sqes_size = 0;
+        unsigned* sq_tail = nullptr;
+        unsigned sq_mask = 0;
+        unsigned* sq_array = nullptr;
+        unsigned* cq_head = nullptr;
+        unsigned* cq_tail = nullptr;
+        unsigned cq_mask = 0;
+        io_uring_cqe* cqes = nullptr;
+        unsigned local_tail = 0;
+        unsigned unsubmitted = 0;
+    };
+
+    struct channel_t {
+        size_t conId;
+        int fd = -1;
+
+        std::mutex sendLock;
+        uint64_t next_message_id = 0;
+        char* staging = nullptr;  // Registered with uring, holds frame header and meta data of the frame being sent
+        std::unique_ptr<uring_t> uring;
+        bool zero_copy = false;
+
+        std::atomic<bool> running{true};
+        std::thread receiver;
+
+        ~channel_t() {
+            free(staging);
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    };
+
+    SocketTransport() = default;
+
+    std::shared_ptr<channel_t> getChannel(const size_t conId) const {
+        std::shared_lock<std::shared_mutex> lk(channelLock);
+        auto it = channels.find(conId);
+        return (it == channels.end()) ? nullptr : it->second;
+    }
+
+    bool addChannel(const size_t conId, const int fd) {
+        const int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &SOCKET_BUFFER_SIZE, sizeof(SOCKET_BUFFER_SIZE));
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &SOCKET_BUFFER_SIZE, sizeof(SOCKET_BUFFER_SIZE));
+
+        auto channel = std::make_shared<channel_t>();
+        channel->conId = conId;
+        channel->fd = fd;
+        channel->staging = reinterpret_cast<char*>(aligned_alloc(4096, STAGING_SIZE));
+
+        auto uring = std::make_unique<uring_t>();
+        if (uring->init(URING_ENTRIES)) {
+            channel->zero_copy = uring->supports(IORING_OP_SEND_ZC) && uring->registerBuffer(channel->staging, STAGING_SIZE);
+            channel->uring = std::move(uring);
+        }
+
+        channel->receiver = std::thread([this, ch = channel.get()] { receive(ch); });
+        {
+            std::unique_lock<std::shared_mutex> lk(channelLock);
+            channels[conId] = channel;
+        }
+
+        const char* mode = channel->zero_copy ? "io_uring zero-copy" : (channel->uring ? "io_uring" : "sendmsg");
+        LOG_INFO("[SocketTransport] Connection " << conId << " established, sending with " << mode << std::endl;)
+        return true;
+    }
+
+    void shutdownChannel(channel_t& channel) {
+        channel.running = false;
+        ::shutdown(channel.fd, SHUT_RDWR);
+        if (channel.receiver.joinable()) {
+            channel.receiver.join();
+        }
+    }
+
+    struct segment_t {
+        const char* data;
+        size_t size;
+        size_t sent;
+    };
+
+    // Called with sendLock held
+    bool sendFrame(channel_t& channel, const frame_t& frame, const char* meta, const char* payload) {
+        memcpy(channel.staging, &frame, sizeof(frame_t));
+        if (frame.meta_size) {
+            memcpy(channel.staging + FRAME_HEADER_SIZE, meta, frame.meta_size);
+        }
+        size_t staged = FRAME_HEADER_SIZE + frame.meta_size;
+
+        // Small payloads travel in the staging buffer together with the header
+        std::vector<segment_t> segments;
+        if (frame.payload_size < ZERO_COPY_THRESHOLD && staged + frame.payload_size <= STAGING_SIZE) {
+            if (frame.payload_size) {
+                memcpy(channel.staging + staged, payload, frame.payload_size);
+            }
+            staged += frame.payload_size;
+            segments.push_back({channel.staging, staged, 0});
+        } else {
+            segments.push_back({channel.staging, staged, 0});
+            segments.push_back({payload, frame.payload_size, 0});
+        }
+
+        if (channel.uring && !submitSegments(channel, segments)) {
+            return false;
+        }
+        return sendRemaining(channel.fd, segments);
+    }
+
+    /* Submits all segments as one linked chain and waits for their completions, including the zero-copy notifications.
+     * A short or failed send leaves the segment's sent counter behind, the caller writes the rest with sendmsg.
+     * On an error the remaining completions are still drained, the kernel may read the staging buffer until its notification arrived.
+     */
+    bool submitSegments(channel_t& channel, std::vector<segment_t>& segments) {
+        uring_t& uring = *channel.uring;
+        for (size_t i = 0; i < segments.size(); ++i) {
+            io_uring_sqe* sqe = uring.nextSqe();
+            const bool staging = (i == 0);
+            const bool zero_copy = channel.zero_copy && (staging || segments[i].size >= ZERO_COPY_THRESHOLD);
+            sqe->opcode = zero_copy ? IORING_OP_SEND_ZC : IORING_OP_SEND;
+            sqe->fd = channel.fd;
+            sqe->addr = reinterpret_cast<uint64_t>(segments[i].data);
+            sqe->len = static_cast<uint32_t>(segments[i].size);
+            sqe->msg_flags = MSG_WAITALL | MSG_NOSIGNAL;
+            sqe->user_data = i;
+            if (zero_copy && staging) {
+                sqe->ioprio = IORING_RECVSEND_FIXED_BUF;
+                sqe->buf_index = 0;
+            }
+            if (i + 1 < segments.size()) {
+                sqe->flags = IOSQE_IO_LINK;
+            }
+        }
+
+        size_t results = 0;
+        size_t notifications = 0;
+        int error = 0;
+        while (results < segments.size() || notifications > 0) {
+            if (uring.enter(1) < 0) {
+                return false;
+            }
+            io_uring_cqe cqe;
+            while (uring.popCqe(cqe)) {
+                if (cqe.flags & IORING_CQE_F_NOTIF) {
+                    --notifications;
+                    continue;
+                }
+                ++results;
+                if (cqe.flags & IORING_CQE_F_MORE) {
+                    ++notifications;
+                }
+                if (cqe.res > 0) {
+                    segments[cqe.user_data].sent = static_cast<size_t>(cqe.res);
+                } else if (cqe.res < 0 && cqe.res != -ECANCELED && cqe.res != -EINTR && cqe.res != -EAGAIN && error == 0) {
+                    error = -cqe.res;
+                }
+            }
+        }
+        if (error != 0) {
+            errno = error;
+            return false;
+        }
+        return true;
+    }
+
+    static bool sendRemaining(const int fd, std::vector<segment_t>& segments) {
+        iovec iov[2];
+        for (;;) {
+            size_t count = 0;
+            for (auto& segment : segments) {
+                if (segment.sent < segment.size) {
+                    iov[count++] = iovec{const_cast<char*>(segment.data + segment.sent), segment.size - segment.sent};
+                }
+            }
+            if (count == 0) {
+                return true;
+            }
+
+            msghdr message{};
+            message.msg_iov = iov;
+            message.msg_iovlen = count;
+            ssize_t written = sendmsg(fd, &message, MSG_NOSIGNAL);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            for (auto& segment : segments) {
+                const size_t step = std::min(static_cast<size_t>(written), segment.size - segment.sent);
+                segment.sent += step;
+                written -= step;
+            }
+        }
+    }
+
+    static bool receiveAll(const int fd, char* dst, size_t size) {
+        while (size > 0) {
+            const ssize_t received = recv(fd, dst, size, MSG_WAITALL);
+            if (received <= 0) {
+                if (received < 0 && errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            dst += received;
+            size -= received;
+        }
+        return true;
+    }
+
+    void receive(channel_t* channel) {
+        char header[FRAME_HEADER_SIZE];
+        std::vector<char> meta;
+        std::vector<char> payload(DEFAULT_PACKAGE_SIZE);
+
+        while (channel->running.load()) {
+            if (!receiveAll(channel->fd, header, FRAME_HEADER_SIZE)) {
+                break;
+            }
+            frame_t frame;
+            memcpy(&frame, header, sizeof(frame_t));
+            if (frame.magic != FRAME_MAGIC) {
+                LOG_ERROR("[SocketTransport] Connection " << channel->conId << " received a corrupted frame, closing." << std::endl;)
+                break;
+            }
+
+            meta.resize(frame.meta_size);
+            if (frame.payload_size > payload.size()) {
+                payload.resize(frame.payload_size);
+            }
+            if (!receiveAll(channel->fd, meta.data(), frame.meta_size) || !receiveAll(channel->fd, payload.data(), frame.payload_size)) {
+                break;
+            }
+
+            transport_message_t message{frame.code, payload.data(), meta.data(), frame.meta_size, frame.message_id, frame.total_data_size, frame.payload_size, frame.package_number, frame.payload_position_offset};
+            dispatch(channel->conId, message);
+        }
+
+        if (channel->running.load()) {
+            LOG_WARNING("[SocketTransport] Connection " << channel->conId << " was closed by the peer." << std::endl;)
+        }
+    }
+
+    std::map<size_t, std::shared_ptr<channel_t>> channels;
+    mutable std::shared_mutex channelLock;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+
+/* Destination of a direct (one-sided) write, announced by the consumer for one of its remote columns.
+ * owner identifies the announcing process, a transport must refuse regions it cannot reach.
+ */
+struct direct_region_t {
+    uint64_t address = 0;
+    size_t size = 0;
+    uint64_t owner = 0;
+
+    // Random per process identity, used to tell apart regions of this process from regions of a peer.
+    static uint64_t process_token() {
+        static const uint64_t token = std::random_device{}() | (static_cast<uint64_t>(std::random_device{}()) << 32);
+        return token;
+    }
+};
+
+class DirectWriteTransport {
+   public:
+    virtual ~DirectWriteTransport() = default;
+
+    // Writes size bytes of src to region.address + offset. Returns false if the region is not writable, the caller falls back to messages.
+    virtual bool write(const direct_region_t& region, const size_t offset, const char* src, const size_t size) = 0;
+    virtual std::string name() const = 0;
+};
+
+/* Copy-based emulation of one-sided writes for provider and consumer living in the same process.
+ * Regions announced by other processes are rejected.
+ */
+class LoopbackTransport : public DirectWriteTransport {
+   public:
+    bool write(const direct_region_t& region, const size_t offset, const char* src, const size_t size) override {
+        if (region.owner != direct_region_t::process_token() || offset + size > region.size) {
+            return false;
+        }
+        memcpy(reinterpret_cast<char*>(region.address) + offset, src, size);
+        return true;
+    }
+
+    std::string name() const override {
+        return "loopback";
+    }
+};
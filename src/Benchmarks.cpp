@@ -5,8 +5,12 @@
 
 #include <barrier>
 #include <future>
+#include <limits>
 
+#include "Compression.hpp"
 #include "Operators.hpp"
+#include "SSB.hpp"
+#include "SimdSelection.hpp"
 
 Benchmarks::Benchmarks() {
     // for (auto& worker : workers) {
@@ -24,11 +28,19 @@ inline void reset_timer() {
     workingTime = std::chrono::duration<double>::zero();
 }
 
+// The kernels here scan front to back, everything before _data is done with and its receive budget is given back
 inline void wait_col_data_ready(col_t* _col, char* _data) {
     auto s_ts = std::chrono::high_resolution_clock::now();
+    if (_col->is_remote) {
+        _col->consume_until(_data - reinterpret_cast<char*>(_col->data));
+    }
     std::unique_lock<std::mutex> lk(_col->iteratorLock);
     if (!(_data < reinterpret_cast<char*>(_col->current_end))) {
-        _col->iterator_data_available.wait(lk, [_col, _data] { return reinterpret_cast<char*>(_data) < reinterpret_cast<char*>(_col->current_end); });
+        _col->iterator_data_available.wait(lk, [_col, _data] { return reinterpret_cast<char*>(_data) < reinterpret_cast<char*>(_col->current_end) || _col->retired; });
+        _col->chunk_tuner.on_stall(std::chrono::high_resolution_clock::now() - s_ts);
+        if (_col->retired) {
+            LOG_ERROR("[Benchmarks] Column " << _col->ident << " was replaced on the provider while being scanned, results are invalid." << std::endl;)
+        }
     }
     waitingTime += (std::chrono::high_resolution_clock::now() - s_ts);
 }
@@ -1942,6 +1954,458 @@ void Benchmarks::execRDMAHashJoinStarBenchmark() {
     }
 }
 
+void Benchmarks::execSSBBenchmark() {
+    const double scaleFactor = 10;
+    const uint64_t localNumaNode = 0;
+    const uint64_t remoteNumaNode = 1;
+    const uint64_t maxWorkers = 16;
+    const uint64_t maxRuns = 5;
+
+    auto in_time_t = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::stringstream logNameStream;
+    logNameStream << "results/ssb/" << std::put_time(std::localtime(&in_time_t), "%Y-%m-%d-%H-%M-%S_") << "SSB_" << scaleFactor << ".tsv";
+    std::string logName = logNameStream.str();
+
+    LOG_INFO("[Task] Set name: " << logName << std::endl;)
+
+    std::ofstream out;
+    out.open(logName, std::ios_base::app);
+    out << std::fixed << std::setprecision(7);
+    out << "mode\tquery\tworkers\trows\tgroups\ttime[ns]\tbwdh\n"
+        << std::flush;
+
+    for (ssb_mode_t mode : {ssb_mode_t::local, ssb_mode_t::numa, ssb_mode_t::remote}) {
+        DataCatalog::getInstance().clear(true);
+        DataCatalog::getInstance().generateSSBData(scaleFactor, (mode == ssb_mode_t::numa) ? remoteNumaNode : localNumaNode, mode == ssb_mode_t::remote);
+
+        for (size_t workers = 1; workers <= maxWorkers; workers *= 2) {
+            for (size_t query = 0; query < SSB::QUERY_COUNT; ++query) {
+                LOG_INFO(" --- Running " << SSB::query_name(query) << " / " << SSB::mode_to_string(mode) << " / Workers: " << workers << " --- " << std::endl;)
+                for (size_t runs = 0; runs < maxRuns; ++runs) {
+                    // Remote runs start without any resident column, so every run includes the transfer
+                    if (mode == ssb_mode_t::remote) {
+                        DataCatalog::getInstance().eraseAllRemoteColumns();
+                        DataCatalog::getInstance().fetchRemoteInfo();
+                    }
+
+                    auto start = std::chrono::high_resolution_clock::now();
+                    const ssb_result_t result = SSB::execute(query, mode, workers);
+                    auto end = std::chrono::high_resolution_clock::now();
+                    const size_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+                    if (!result.valid) {
+                        LOG_ERROR("[SSB] " << SSB::query_name(query) << " failed, skipping the remaining runs." << std::endl;)
+                        break;
+                    }
+
+                    const double wallclock_bwdh = calculate_MiB_per_s(result.bytes, duration);
+                    LOG_SUCCESS(std::fixed << std::setprecision(7) << SSB::query_name(query) << "\tGroups: " << result.groups.size() << "\tWallclock bandwidth: " << wallclock_bwdh << std::endl;)
+                    out << SSB::mode_to_string(mode) << "\t" << SSB::query_name(query) << "\t" << workers << "\t" << result.rows << "\t" << result.groups.size() << "\t" << duration << "\t" << wallclock_bwdh << std::endl
+                        << std::flush;
+                }
+            }
+        }
+    }
+    DataCatalog::getInstance().clear(true);
+
+    LOG_NOFORMAT(std::endl;)
+    LOG_INFO("SSB Benchmark ended." << std::endl;)
+
+    out.close();
+}
+
+namespace {
+
+/* Runs the correctness checks of a benchmark ahead of its measurements, numbers of a broken kernel are worthless.
+ * All checks run so every mismatch gets logged, false if any of them failed.
+ */
+bool verifyBeforeMeasuring(const std::string& benchmark, const std::string& what, const std::vector<std::function<bool()>>& checks) {
+    bool valid = true;
+    for (const auto& check : checks) {
+        valid = check() && valid;
+    }
+    if (!valid) {
+        LOG_ERROR("[" << benchmark << "] " << what << " failed, not measuring." << std::endl;)
+        return false;
+    }
+    LOG_SUCCESS("[" << benchmark << "] " << what << " passed." << std::endl;)
+    return true;
+}
+
+/* Compresses and decompresses edge case inputs with every codec. A decoded value differing from the input, a rejected
+ * valid message or an accepted truncated one is reported as error and fails the verification.
+ */
+template <typename T>
+bool verifyCompressionRoundTrip(const std::string& type) {
+    const std::vector<size_t> counts = {1, Compression::BLOCK_ELEMENTS - 1, Compression::BLOCK_ELEMENTS, Compression::BLOCK_ELEMENTS + 1, 1000, 65536 + 17};
+    std::mt19937_64 generator(7);
+    bool valid = true;
+
+    for (size_t count : counts) {
+        std::vector<T> input(count);
+        std::vector<T> output(count);
+        std::vector<char> compressed(count * sizeof(T) + Compression::HEADER_SIZE);
+
+        for (std::string pattern : {"uniform_full", "uniform_small", "sorted", "runs", "constant", "extremes"}) {
+            for (size_t i = 0; i < count; ++i) {
+                if (pattern == "uniform_full") {
+                    input[i] = static_cast<T>(generator());
+                } else if (pattern == "uniform_small") {
+                    input[i] = static_cast<T>(generator() % 8);
+                } else if (pattern == "sorted") {
+                    input[i] = static_cast<T>(i * 3);
+                } else if (pattern == "runs") {
+                    input[i] = static_cast<T>(i / 37);
+                } else if (pattern == "constant") {
+                    input[i] = std::numeric_limits<T>::max();
+                } else {
+                    input[i] = (i % 2) ? std::numeric_limits<T>::max() : 0;
+                }
+            }
+
+            for (auto codec : {chunk_codec_t::for_bitpack, chunk_codec_t::delta_bitpack, chunk_codec_t::rle}) {
+                const size_t compressedBytes = Compression::compress<T>(codec, input.data(), count, compressed.data(), compressed.size());
+                if (compressedBytes == 0) {
+                    // Does not shrink, the range would be sent raw
+                    continue;
+                }
+
+                std::fill(output.begin(), output.end(), static_cast<T>(0x5A));
+                const std::string name = type + " " + pattern + " " + Compression::codec_to_string(codec) + " count " + std::to_string(count);
+                if (!Compression::decompress<T>(codec, compressed.data(), compressedBytes, output.data(), count)) {
+                    LOG_ERROR("[CompressionBenchmark] Decoder rejected valid " << name << std::endl;)
+                    valid = false;
+                } else if (memcmp(input.data(), output.data(), count * sizeof(T)) != 0) {
+                    LOG_ERROR("[CompressionBenchmark] Roundtrip mismatch for " << name << std::endl;)
+                    valid = false;
+                }
+                for (size_t truncated : {size_t(0), size_t(4), compressedBytes - 1}) {
+                    if (truncated < compressedBytes && Compression::decompress<T>(codec, compressed.data(), truncated, output.data(), count)) {
+                        LOG_ERROR("[CompressionBenchmark] Decoder accepted " << truncated << " of " << compressedBytes << " Bytes for " << name << std::endl;)
+                        valid = false;
+                    }
+                }
+            }
+        }
+    }
+    return valid;
+}
+
+}  // namespace
+
+void Benchmarks::execCompressionBenchmark() {
+    auto in_time_t = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::stringstream logNameStream;
+    logNameStream << std::put_time(std::localtime(&in_time_t), "%Y-%m-%d-%H-%M-%S_") << "CompressionBenchmark.tsv";
+    std::string logName = logNameStream.str();
+
+    LOG_INFO("[Task] Set name: " << logName << std::endl;)
+
+    if (!verifyBeforeMeasuring("CompressionBenchmark", "Codec round trips", {[] { return verifyCompressionRoundTrip<uint8_t>("uint8_t"); }, [] { return verifyCompressionRoundTrip<uint64_t>("uint64_t"); }})) {
+        return;
+    }
+
+    std::ofstream out;
+    out.open(logName, std::ios_base::app);
+    out << std::fixed << std::setprecision(7) << std::endl;
+    out << "distribution\tcodec\traw_bytes\tcompressed_bytes\tratio\tcompress_bwdh\tdecompress_bwdh\tlink_bwdh\traw_transfer_time\tcompressed_transfer_time\tspeedup\n"
+        << std::flush;
+
+    const size_t elementCount = 4194304;  // one 32 MiB chunk of uint64_t
+    const size_t maxRuns = 10;
+    // Modeled link bandwidths in GiB/s, from a slow TCP link to a 200 Gbit/s RDMA link
+    const std::vector<double> linkBandwidths = {1.0, 3.0, 12.5, 25.0};
+
+    std::vector<uint64_t> input(elementCount);
+    std::vector<uint64_t> output(elementCount);
+    std::vector<char> compressed(elementCount * sizeof(uint64_t));
+    std::mt19937_64 generator(42);
+
+    for (std::string distribution : {"uniform_full", "uniform_small", "sorted", "runs"}) {
+        if (distribution == "uniform_full") {
+            std::uniform_int_distribution<uint64_t> dist;
+            for (auto& v : input) v = dist(generator);
+        } else if (distribution == "uniform_small") {
+            std::uniform_int_distribution<uint64_t> dist(0, 1000);
+            for (auto& v : input) v = dist(generator);
+        } else if (distribution == "sorted") {
+            std::uniform_int_distribution<uint64_t> dist(0, 16);
+            uint64_t current = 1000000;
+            for (auto& v : input) v = (current += dist(generator));
+        } else {
+            std::uniform_int_distribution<uint64_t> dist(0, 100);
+            std::uniform_int_distribution<size_t> len(32, 512);
+            for (size_t i = 0; i < elementCount;) {
+                const uint64_t value = dist(generator);
+                for (size_t l = len(generator); l > 0 && i < elementCount; --l, ++i) input[i] = value;
+            }
+        }
+
+        const auto estimate = Compression::choose_codec<uint64_t>(input.data(), elementCount);
+        LOG_INFO("[CompressionBenchmark] " << distribution << " chooses " << Compression::codec_to_string(estimate.codec) << std::endl;)
+
+        for (auto codec : {chunk_codec_t::for_bitpack, chunk_codec_t::delta_bitpack, chunk_codec_t::rle}) {
+            const size_t rawBytes = elementCount * sizeof(uint64_t);
+            size_t compressedBytes = 0;
+            std::chrono::duration<double> compressTime = std::chrono::duration<double>::zero();
+            std::chrono::duration<double> decompressTime = std::chrono::duration<double>::zero();
+
+            for (size_t run = 0; run < maxRuns; ++run) {
+                auto s_ts = std::chrono::high_resolution_clock::now();
+                compressedBytes = Compression::compress<uint64_t>(codec, input.data(), elementCount, compressed.data(), compressed.size());
+                compressTime += std::chrono::high_resolution_clock::now() - s_ts;
+
+                if (compressedBytes == 0) {
+                    break;
+                }
+
+                s_ts = std::chrono::high_resolution_clock::now();
+                Compression::decompress<uint64_t>(codec, compressed.data(), compressedBytes, output.data(), elementCount);
+                decompressTime += std::chrono::high_resolution_clock::now() - s_ts;
+            }
+
+            if (compressedBytes == 0) {
+                LOG_INFO("[CompressionBenchmark] " << distribution << " does not shrink with " << Compression::codec_to_string(codec) << ", sent raw." << std::endl;)
+                continue;
+            }
+
+            if (memcmp(input.data(), output.data(), rawBytes) != 0) {
+                LOG_ERROR("[CompressionBenchmark] Roundtrip mismatch for " << distribution << " with " << Compression::codec_to_string(codec) << std::endl;)
+                continue;
+            }
+
+            const double gib = static_cast<double>(rawBytes) / 1024 / 1024 / 1024;
+            const double compressSeconds = compressTime.count() / maxRuns;
+            const double decompressSeconds = decompressTime.count() / maxRuns;
+            const double ratio = static_cast<double>(rawBytes) / compressedBytes;
+
+            for (double link : linkBandwidths) {
+                // Encoding, transfer and decoding are not overlapped in this model, i.e. the numbers are a lower bound.
+                const double rawTransfer = gib / link;
+                const double compressedTransfer = compressSeconds + (gib / ratio) / link + decompressSeconds;
+
+                out << distribution << "\t" << Compression::codec_to_string(codec) << "\t" << rawBytes << "\t" << compressedBytes << "\t" << ratio << "\t"
+                    << gib / compressSeconds << "\t" << gib / decompressSeconds << "\t" << link << "\t" << rawTransfer << "\t" << compressedTransfer << "\t"
+                    << rawTransfer / compressedTransfer << std::endl;
+            }
+
+            LOG_SUCCESS(std::fixed << std::setprecision(3) << distribution << "\t" << Compression::codec_to_string(codec) << "\tRatio: " << ratio << "\tCompress: " << gib / compressSeconds << " GiB/s\tDecompress: " << gib / decompressSeconds << " GiB/s" << std::endl;)
+        }
+    }
+
+    out.close();
+    LOG_INFO("[CompressionBenchmark] Done." << std::endl;)
+}
+
+namespace {
+
+// The scalar Operators kernels the vectorized ones replace
+std::vector<size_t> selectWithOperators(const compare_op_t op, uint64_t* data, const uint64_t predicate_1, const uint64_t predicate_2, const size_t blockSize) {
+    switch (op) {
+        case compare_op_t::less_than:
+            return Operators::less_than<true>(data, predicate_1, blockSize, {});
+        case compare_op_t::less_equal:
+            return Operators::less_equal<true>(data, predicate_1, blockSize, {});
+        case compare_op_t::greater_than:
+            return Operators::greater_than<true>(data, predicate_1, blockSize, {});
+        case compare_op_t::greater_equal:
+            return Operators::greater_equal<true>(data, predicate_1, blockSize, {});
+        case compare_op_t::equal:
+            return Operators::equal<true>(data, predicate_1, blockSize, {});
+        case compare_op_t::between_incl:
+            return Operators::between_incl<true>(data, predicate_1, predicate_2, blockSize, {});
+        case compare_op_t::between_excl:
+            return Operators::between_excl<true>(data, predicate_1, predicate_2, blockSize, {});
+    }
+    return {};
+}
+
+// The predicate as plain comparisons, the reference all kernels are compared against
+template <typename T>
+bool matchesReference(const compare_op_t op, const T v, const T predicate_1, const T predicate_2) {
+    switch (op) {
+        case compare_op_t::less_than:
+            return v < predicate_1;
+        case compare_op_t::less_equal:
+            return v <= predicate_1;
+        case compare_op_t::greater_than:
+            return v > predicate_1;
+        case compare_op_t::greater_equal:
+            return v >= predicate_1;
+        case compare_op_t::equal:
+            return v == predicate_1;
+        case compare_op_t::between_incl:
+            return predicate_1 <= v && v <= predicate_2;
+        case compare_op_t::between_excl:
+            return predicate_1 < v && v < predicate_2;
+    }
+    return false;
+}
+
+/* Runs every operator at every detected SIMD level on counts around the vector widths, unaligned input and extreme values.
+ * Positions differing from the plain loop, or writes past count + OUTPUT_SLACK, are reported as error and fail the verification.
+ */
+template <typename T>
+bool verifySelection(const std::string& type, const double domain) {
+    const std::vector<size_t> counts = {0, 1, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129, 1000, 4099};
+    const size_t GUARD = 16;
+    const size_t GUARD_VALUE = std::numeric_limits<size_t>::max();
+    std::mt19937_64 generator(11);
+    std::uniform_real_distribution<double> dist(0, domain);
+    const simd_level_t previous = SimdSelection::level();
+    bool valid = true;
+
+    for (size_t count : counts) {
+        // One element in front, so the kernels also see input that is not vector aligned
+        std::vector<T> storage(count + 1);
+        for (size_t i = 0; i < storage.size(); ++i) {
+            const size_t pick = generator() % 16;
+            storage[i] = (pick == 0) ? std::numeric_limits<T>::lowest() : (pick == 1) ? std::numeric_limits<T>::max() : static_cast<T>(dist(generator));
+        }
+        const T* data = storage.data() + 1;
+
+        const std::vector<std::pair<T, T>> predicates = {{static_cast<T>(domain / 4), static_cast<T>(domain * 3 / 4)},
+                                                         {storage[(count + 1) / 2], storage[(count + 1) / 2]},
+                                                         {std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max()},
+                                                         {std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest()}};
+        for (const auto& [predicate_1, predicate_2] : predicates) {
+            for (uint8_t o = 0; o <= static_cast<uint8_t>(compare_op_t::between_excl); ++o) {
+                const compare_op_t op = static_cast<compare_op_t>(o);
+                std::vector<size_t> expected;
+                for (size_t i = 0; i < count; ++i) {
+                    if (matchesReference(op, data[i], predicate_1, predicate_2)) expected.push_back(i);
+                }
+
+                for (uint8_t l = 0; l <= static_cast<uint8_t>(SimdSelection::detected_level()); ++l) {
+                    const simd_level_t level = SimdSelection::set_level(static_cast<simd_level_t>(l));
+                    std::vector<size_t> positions(count + SimdSelection::OUTPUT_SLACK + GUARD, GUARD_VALUE);
+                    const size_t matched = SimdSelection::select(op, data, count, predicate_1, predicate_2, positions.data());
+
+                    const std::string name = type + " " + SimdSelection::op_to_string(op) + " " + SimdSelection::level_to_string(level) + " count " + std::to_string(count);
+                    if (matched != expected.size() || !std::equal(expected.begin(), expected.end(), positions.begin())) {
+                        LOG_ERROR("[SelectionBenchmark] " << name << " selected " << matched << " positions, expected " << expected.size() << std::endl;)
+                        valid = false;
+                    }
+                    if (std::any_of(positions.end() - GUARD, positions.end(), [GUARD_VALUE](size_t p) { return p != GUARD_VALUE; })) {
+                        LOG_ERROR("[SelectionBenchmark] " << name << " wrote past count + OUTPUT_SLACK positions" << std::endl;)
+                        valid = false;
+                    }
+                }
+            }
+        }
+    }
+    SimdSelection::set_level(previous);
+    return valid;
+}
+
+/* Scans a uniform column in [0, domain) blockwise with every operator at the given selectivities.
+ * The predicates are derived from the selectivity, equal always matches about 1 / domain of the rows, the measured one is logged.
+ */
+template <typename T>
+void runSelectionBenchmark(std::ofstream& out, const std::string& type, const double domain, const std::vector<double>& selectivities) {
+    const size_t elementCount = 16777216;
+    const size_t blockSize = Benchmarks::OPTIMAL_BLOCK_SIZE;
+    const size_t maxRuns = 5;
+
+    std::vector<T> data(elementCount);
+    std::mt19937_64 generator(42);
+    std::uniform_real_distribution<double> dist(0, domain);
+    for (auto& v : data) v = static_cast<T>(dist(generator));
+
+    std::vector<size_t> positions(blockSize + SimdSelection::OUTPUT_SLACK);
+    const double gib = static_cast<double>(elementCount * sizeof(T)) / 1024 / 1024 / 1024;
+
+    for (double selectivity : selectivities) {
+        const double cut = selectivity * domain;
+        for (uint8_t o = 0; o <= static_cast<uint8_t>(compare_op_t::between_excl); ++o) {
+            const compare_op_t op = static_cast<compare_op_t>(o);
+            T predicate_1;
+            T predicate_2 = 0;
+            if (op == compare_op_t::less_than || op == compare_op_t::less_equal || op == compare_op_t::equal) {
+                predicate_1 = static_cast<T>(cut);
+            } else if (op == compare_op_t::greater_than || op == compare_op_t::greater_equal) {
+                predicate_1 = static_cast<T>(domain - cut);
+            } else {
+                predicate_1 = static_cast<T>((domain - cut) / 2);
+                predicate_2 = static_cast<T>((domain + cut) / 2);
+            }
+
+            // The current scalar Operators only exist for uint64_t, otherwise the scalar kernel is the baseline
+            std::vector<std::string> kernels;
+            if constexpr (std::is_same_v<T, uint64_t>) kernels.push_back("operators");
+            for (uint8_t l = 0; l <= static_cast<uint8_t>(SimdSelection::detected_level()); ++l) {
+                kernels.push_back(SimdSelection::level_to_string(static_cast<simd_level_t>(l)));
+            }
+
+            double baselineSeconds = 0;
+            for (size_t k = 0; k < kernels.size(); ++k) {
+                if (kernels[k] != "operators") SimdSelection::set_level(static_cast<simd_level_t>(k - (kernels[0] == "operators")));
+
+                size_t matched = 0;
+                auto s_ts = std::chrono::high_resolution_clock::now();
+                for (size_t run = 0; run < maxRuns; ++run) {
+                    matched = 0;
+                    for (size_t offset = 0; offset < elementCount; offset += blockSize) {
+                        const size_t count = std::min(blockSize, elementCount - offset);
+                        if constexpr (std::is_same_v<T, uint64_t>) {
+                            if (kernels[k] == "operators") {
+                                matched += selectWithOperators(op, data.data() + offset, predicate_1, predicate_2, count).size();
+                                continue;
+                            }
+                        }
+                        matched += SimdSelection::select(op, data.data() + offset, count, predicate_1, predicate_2, positions.data());
+                    }
+                }
+                const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - s_ts).count() / maxRuns;
+                if (k == 0) baselineSeconds = seconds;
+
+                const double measured = static_cast<double>(matched) / elementCount;
+                out << type << "\t" << SimdSelection::op_to_string(op) << "\t" << selectivity << "\t" << measured << "\t" << kernels[k] << "\t" << seconds * 1e9 << "\t"
+                    << gib / seconds << "\t" << baselineSeconds / seconds << std::endl;
+                LOG_SUCCESS(std::fixed << std::setprecision(3) << type << "\t" << SimdSelection::op_to_string(op) << "\tSelectivity: " << measured << "\t" << kernels[k]
+                                       << "\t" << gib / seconds << " GiB/s\tSpeedup: " << baselineSeconds / seconds << std::endl;)
+            }
+        }
+    }
+    SimdSelection::set_level(SimdSelection::detected_level());
+}
+
+}  // namespace
+
+void Benchmarks::execSelectionBenchmark() {
+    auto in_time_t = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::stringstream logNameStream;
+    logNameStream << std::put_time(std::localtime(&in_time_t), "%Y-%m-%d-%H-%M-%S_") << "SelectionBenchmark.tsv";
+    std::string logName = logNameStream.str();
+
+    LOG_INFO("[Task] Set name: " << logName << std::endl;)
+    LOG_INFO("[SelectionBenchmark] Detected SIMD level: " << SimdSelection::level_to_string(SimdSelection::detected_level()) << std::endl;)
+
+    const std::vector<std::function<bool()>> selectionChecks = {[] { return verifySelection<uint64_t>("uint64_t", 1048576); },
+                                                                [] { return verifySelection<uint8_t>("uint8_t", 256); },
+                                                                [] { return verifySelection<float>("float", 1048576); },
+                                                                [] { return verifySelection<double>("double", 1048576); }};
+    if (!verifyBeforeMeasuring("SelectionBenchmark", "Comparing the SIMD kernels with the scalar selection", selectionChecks)) {
+        return;
+    }
+
+    std::ofstream out;
+    out.open(logName, std::ios_base::app);
+    out << std::fixed << std::setprecision(7) << std::endl;
+    out << "type\toperator\tselectivity\tmeasured_selectivity\tkernel\ttime[ns]\tbwdh\tspeedup\n"
+        << std::flush;
+
+    const std::vector<double> selectivities = {0.001, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99};
+
+    runSelectionBenchmark<uint64_t>(out, "uint64_t", 1048576, selectivities);
+    runSelectionBenchmark<uint8_t>(out, "uint8_t", 256, selectivities);
+    runSelectionBenchmark<float>(out, "float", 1048576, selectivities);
+    runSelectionBenchmark<double>(out, "double", 1048576, selectivities);
+
+    out.close();
+    LOG_INFO("[SelectionBenchmark] Done." << std::endl;)
+}
+
 void Benchmarks::executeAllBenchmarks() {
     // auto in_time_t = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
     // std::stringstream logNameStreamSW;
@@ -1984,4 +2448,8 @@ void Benchmarks::executeAllBenchmarks() {
 
     execRDMAHashJoinPGBenchmark();
     // execRDMAHashJoinStarBenchmark();
+    // execSSBBenchmark();
+
+    // execCompressionBenchmark();
+    // execSelectionBenchmark();
 }
\ No newline at end of file
@@ -5,13 +5,73 @@
 #include <TaskManager.h>
 #include <Utility.h>
 
+#include <algorithm>
 #include <thread>
 
 #include "Benchmarks.hpp"
+#include "FileLoader.hpp"
+#include "SSB.hpp"
+#include "ShmTransport.hpp"
+#include "SocketTransport.hpp"
 #include "Worker.hpp"
 
 using namespace memordma;
 
+// Connections served by one of these transports bypass the ConnectionManager
+static std::array<MessageTransport*, 2> messageTransports() {
+    return {&ShmTransport::getInstance(), &SocketTransport::getInstance()};
+}
+
+static MessageTransport* transportOf(std::size_t conId) {
+    for (auto transport : messageTransports()) {
+        if (transport->hasChannel(conId)) {
+            return transport;
+        }
+    }
+    return nullptr;
+}
+
+/* Catalog messages of a connection go over its shared memory or socket channel if one is open, otherwise over RDMA.
+ * All transports copy data and meta data before returning.
+ */
+static int sendMessage(std::size_t conId, char* data, std::size_t size, char* appMetaData, std::size_t appMetaSize, uint8_t code) {
+    if (auto transport = transportOf(conId)) {
+        return transport->sendData(conId, data, size, appMetaData, appMetaSize, code);
+    }
+    return ConnectionManager::getInstance().sendData(conId, data, size, appMetaData, appMetaSize, code);
+}
+
+static int sendOpCode(std::size_t conId, uint8_t code) {
+    if (auto transport = transportOf(conId)) {
+        return transport->sendOpCode(conId, code);
+    }
+    return ConnectionManager::getInstance().sendOpCode(conId, code, true);
+}
+
+// Payload bytes of a single message next to appMetaSize bytes of meta data, over whichever transport serves the connection
+std::size_t DataCatalog::maxPayloadSize(std::size_t conId, std::size_t appMetaSize) const {
+    if (auto transport = transportOf(conId)) {
+        return transport->maxBytesInPayload(conId, appMetaSize);
+    }
+    return ConnectionManager::getInstance().getConnectionById(conId)->maxBytesInPayload(appMetaSize);
+}
+
+// Presents a message of a non-RDMA transport like an RDMA receive buffer, so that the same callbacks serve all transports
+struct transport_receive_buffer_t {
+    const transport_message_t* message;
+    mutable package_t::header_t footer;
+
+    char* getPayloadBasePtr() const {
+        return message->payload;
+    }
+    char* getAppMetaPtr() const {
+        return message->meta;
+    }
+    char* getFooterPtr() const {
+        return reinterpret_cast<char*>(&footer);
+    }
+};
+
 DataCatalog::DataCatalog() {
     auto createColLambda = [this]() -> void {
         std::size_t elemCnt;
@@ -56,7 +116,63 @@ DataCatalog::DataCatalog() {
             }
         }
 
-        this->generate(ident, type, elemCnt, 0);
+        char distribution;
+        LOG_CONSOLE("Distribution? uniform [u] zipf [z] sorted [s] clustered [c] correlated [r]" << std::endl;)
+        std::cin >> distribution;
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+
+        gen_spec_t spec;
+        std::string source;
+        switch (distribution) {
+            case 'u': {
+                spec.distribution = gen_distribution_t::uniform;
+                break;
+            }
+            case 'z': {
+                spec.distribution = gen_distribution_t::zipf;
+                LOG_CONSOLE("Skew theta in [0, 1)" << std::endl;)
+                std::cin >> spec.zipf_theta;
+                std::cin.clear();
+                std::cin.ignore(10000, '\n');
+                break;
+            }
+            case 's': {
+                spec.distribution = gen_distribution_t::sorted;
+                break;
+            }
+            case 'c': {
+                spec.distribution = gen_distribution_t::clustered;
+                LOG_CONSOLE("Rows per cluster and cluster width as fraction of the value range" << std::endl;)
+                std::cin >> spec.cluster_rows >> spec.cluster_spread;
+                std::cin.clear();
+                std::cin.ignore(10000, '\n');
+                break;
+            }
+            case 'r': {
+                spec.distribution = gen_distribution_t::correlated;
+                LOG_CONSOLE("Source column and share of values taken from it in [0, 1]" << std::endl;)
+                std::cin >> source >> spec.correlation;
+                std::cin.clear();
+                std::cin.ignore(10000, '\n');
+                break;
+            }
+            default: {
+                LOG_ERROR("Incorrect distribution, aborting." << std::endl;)
+                return;
+            }
+        }
+
+        LOG_CONSOLE("Value range [lower upper] and seed" << std::endl;)
+        std::cin >> spec.lower >> spec.upper >> spec.seed;
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+
+        auto s_ts = std::chrono::high_resolution_clock::now();
+        if (this->generate(ident, type, elemCnt, 0, spec, source)) {
+            std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - s_ts;
+            LOG_CONSOLE("[DataCatalog] Generated " << ident << " in " << secs.count() << " s" << std::endl;)
+        }
     };
 
     auto printColLambda = [this]() -> void {
@@ -70,11 +186,11 @@ DataCatalog::DataCatalog() {
         switch (locality) {
             case 1: {
                 this->print_all();
-                dict = cols;
+                dict = cols.snapshot();
                 break;
             }
             case 2: {
-                dict = remote_cols;
+                dict = remote_cols.snapshot();
                 this->print_all_remotes();
                 break;
             }
@@ -110,11 +226,11 @@ DataCatalog::DataCatalog() {
         switch (locality) {
             case 1: {
                 this->print_all();
-                dict = cols;
+                dict = cols.snapshot();
                 break;
             }
             case 2: {
-                dict = remote_cols;
+                dict = remote_cols.snapshot();
                 this->print_all_remotes();
                 break;
             }
@@ -173,8 +289,9 @@ DataCatalog::DataCatalog() {
         }
     };
 
+    // send_column_info carries the known version and the subscription, every provider is asked for its changes since then
     auto retrieveRemoteColsLambda = [this]() -> void {
-        ConnectionManager::getInstance().sendOpCode(1, static_cast<uint8_t>(catalog_communication_code::send_column_info), true);
+        fetchRemoteInfo(true);
     };
 
     auto logLambda = [this]() -> void {
@@ -188,11 +305,11 @@ DataCatalog::DataCatalog() {
         switch (locality) {
             case 1: {
                 this->print_all();
-                dict = cols;
+                dict = cols.snapshot();
                 break;
             }
             case 2: {
-                dict = remote_cols;
+                dict = remote_cols.snapshot();
                 this->print_all_remotes();
                 break;
             }
@@ -415,6 +532,331 @@ DataCatalog::DataCatalog() {
         Benchmarks::getInstance().executeAllBenchmarks();
     };
 
+    auto benchmarkCompressionLambda = [this]() -> void {
+        Benchmarks::getInstance().execCompressionBenchmark();
+    };
+
+    auto benchmarkSelectionLambda = [this]() -> void {
+        Benchmarks::getInstance().execSelectionBenchmark();
+    };
+
+    auto toggleAdaptiveChunkingLambda = [this]() -> void {
+        dataCatalog_adaptiveChunking = !dataCatalog_adaptiveChunking;
+        LOG_INFO("[DataCatalog] Adaptive chunk sizes for requested columns are now " << (dataCatalog_adaptiveChunking ? "enabled" : "disabled") << std::endl;)
+    };
+
+    auto toggleDirectReceiveLambda = [this]() -> void {
+        dataCatalog_directReceive = !dataCatalog_directReceive;
+        if (dataCatalog_directReceive) {
+            if (directWriteTransport == nullptr) {
+                directWriteTransport = new LoopbackTransport();
+            }
+        } else {
+            // Announced regions may point to columns that are freed later on
+            std::lock_guard<std::mutex> lk(directRegionLock);
+            direct_regions.clear();
+        }
+        LOG_INFO("[DataCatalog] Direct receive into column memory is now " << (dataCatalog_directReceive ? "enabled" : "disabled") << " (" << directWriteTransport->name() << " transport)" << std::endl;)
+    };
+
+    auto toggleCatalogPushLambda = [this]() -> void {
+        dataCatalog_catalogPush = !dataCatalog_catalogPush;
+        LOG_INFO("[DataCatalog] Subscribing to pushed remote catalog updates is now " << (dataCatalog_catalogPush ? "enabled" : "disabled") << std::endl;)
+    };
+
+    auto configureStripingLambda = [this]() -> void {
+        LOG_CONSOLE("[DataCatalog] Primary connection id of the provider" << std::endl;)
+        std::size_t provider;
+        std::cin >> provider;
+        LOG_CONSOLE("[DataCatalog] Connection ids to stripe requests over (space separated, end with 0)" << std::endl;)
+        std::vector<std::size_t> connections;
+        std::size_t conId;
+        while (std::cin >> conId && conId != 0) {
+            connections.push_back(conId);
+        }
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+        LOG_CONSOLE("[DataCatalog] Maximum chunk requests in flight per column" << std::endl;)
+        size_t stripeWidth;
+        std::cin >> stripeWidth;
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+
+        if (connections.empty() || stripeWidth == 0) {
+            LOG_WARNING("[DataCatalog] No valid striping configuration, aborting." << std::endl;)
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lk(placementLock);
+            auto provider_it = providers.find(provider);
+            if (provider_it == providers.end()) {
+                LOG_WARNING("[DataCatalog] Unknown provider " << provider << ", aborting." << std::endl;)
+                return;
+            }
+            for (auto oldConId : provider_it->second.connections) {
+                connection_provider.erase(oldConId);
+            }
+            connection_provider[provider] = provider;
+            for (auto newConId : connections) {
+                connection_provider[newConId] = provider;
+            }
+            provider_it->second.connections = connections;
+        }
+        std::lock_guard<std::mutex> lk(connectionStatsLock);
+        dataCatalog_stripeWidth = stripeWidth;
+        connection_stats.clear();
+    };
+
+    auto configureRequestQoSLambda = [this]() -> void {
+        LOG_CONSOLE("[DataCatalog] Bytes in flight per connection before requests are queued by priority (0 disables queueing)" << std::endl;)
+        size_t window;
+        std::cin >> window;
+        LOG_CONSOLE("[DataCatalog] Weights of the classes interactive, normal and bulk (space separated)" << std::endl;)
+        std::array<double, PRIORITY_CLASSES> weights;
+        for (auto& weight : weights) {
+            std::cin >> weight;
+        }
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+
+        for (auto weight : weights) {
+            if (!(weight > 0)) {
+                LOG_WARNING("[DataCatalog] Priority weights have to be positive, aborting." << std::endl;)
+                return;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lk(connectionStatsLock);
+            dataCatalog_requestWindow = window;
+        }
+        std::lock_guard<std::mutex> lk(sendQueueLock);
+        dataCatalog_priorityWeights = weights;
+        LOG_INFO("[DataCatalog] Request window is now " << dataCatalog_requestWindow << " Bytes" << std::endl;)
+    };
+
+    auto configureReceiveBudgetLambda = [this]() -> void {
+        LOG_CONSOLE("[DataCatalog] Receive budget in Bytes (0 disables the limit)" << std::endl;)
+        size_t budget;
+        std::cin >> budget;
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+        {
+            std::lock_guard<std::mutex> lk(budgetLock);
+            dataCatalog_receiveBudget = budget;
+        }
+        // A larger budget may unblock parked columns right away
+        releaseBudget(0);
+        LOG_INFO("[DataCatalog] Receive budget is now " << budget << " Bytes" << std::endl;)
+    };
+
+    auto configurePrefetchLambda = [this]() -> void {
+        LOG_CONSOLE("[DataCatalog] Prefetch lookahead in Bytes (0 derives it from latency and bandwidth)" << std::endl;)
+        size_t lookahead;
+        std::cin >> lookahead;
+        LOG_CONSOLE("[DataCatalog] Upper bound of a derived lookahead in Bytes" << std::endl;)
+        size_t limit;
+        std::cin >> limit;
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+
+        dataCatalog_prefetchLookahead = lookahead;
+        dataCatalog_prefetchLimit = limit;
+        LOG_INFO("[DataCatalog] Prefetch lookahead is now " << (lookahead ? std::to_string(lookahead) + " Bytes" : "derived, at most " + std::to_string(limit) + " Bytes") << std::endl;)
+    };
+
+    auto openShmChannelLambda = [this]() -> void {
+        LOG_CONSOLE("[DataCatalog] Connection id served by the shared memory channel" << std::endl;)
+        std::size_t conId;
+        std::cin >> conId;
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+        LOG_CONSOLE("[DataCatalog] Name of the shared memory segment" << std::endl;)
+        std::string name;
+        std::cin >> name;
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+        LOG_CONSOLE("[DataCatalog] [1] create (start this side first) [2] attach" << std::endl;)
+        size_t mode;
+        std::cin >> mode;
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+
+        if (!ShmTransport::getInstance().openChannel(conId, name, mode == 1)) {
+            return;
+        }
+        // The attaching side is the consumer, it asks for the catalog right away like after opening an RDMA connection
+        if (mode != 1) {
+            connectProvider(conId);
+        }
+    };
+
+    auto listenSocketLambda = []() -> void {
+        LOG_CONSOLE("[DataCatalog] Connection id served by the socket" << std::endl;)
+        std::size_t conId;
+        std::cin >> conId;
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+        LOG_CONSOLE("[DataCatalog] TCP port" << std::endl;)
+        uint16_t port;
+        std::cin >> port;
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+
+        SocketTransport::getInstance().listen(conId, port);
+    };
+
+    auto connectSocketLambda = [this]() -> void {
+        LOG_CONSOLE("[DataCatalog] Connection id served by the socket" << std::endl;)
+        std::size_t conId;
+        std::cin >> conId;
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+        LOG_CONSOLE("[DataCatalog] Provider host and TCP port (space separated)" << std::endl;)
+        std::string host;
+        uint16_t port;
+        std::cin >> host >> port;
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+
+        if (SocketTransport::getInstance().connect(conId, host, port)) {
+            connectProvider(conId);
+        }
+    };
+
+    auto addProviderLambda = [this]() -> void {
+        LOG_CONSOLE("[DataCatalog] Connection ids of the new provider, primary connection first (space separated, end with 0)" << std::endl;)
+        std::vector<std::size_t> connections;
+        std::size_t conId;
+        while (std::cin >> conId && conId != 0) {
+            connections.push_back(conId);
+        }
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+
+        if (connections.empty()) {
+            LOG_WARNING("[DataCatalog] No connection given, aborting." << std::endl;)
+            return;
+        }
+        addProvider(connections);
+        fetchRemoteInfo();
+    };
+
+    auto fetchTableLambda = [this]() -> void {
+        const auto names = getRemoteTableNames();
+        if (names.empty()) {
+            LOG_WARNING("[DataCatalog] No remote tables known, fetch column info first." << std::endl;)
+            return;
+        }
+        for (auto& name : names) {
+            remote_table_t table;
+            if (find_remote_table(name, table)) {
+                LOG_CONSOLE("[" << name << "]: " << table.columns.size() << " columns, " << table.numRows << " rows, " << (table.isFactTable ? "fact" : "dimension") << " table of provider " << table.provider << std::endl;)
+            }
+        }
+        LOG_CONSOLE("[DataCatalog] Fetch which table?" << std::endl;)
+        std::string ident;
+        std::cin >> ident;
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+
+        fetchTable(ident);
+    };
+
+    auto generateSSBLambda = [this]() -> void {
+        double scaleFactor;
+        uint64_t numaNode;
+        char target;
+        LOG_CONSOLE("[DataCatalog] Scale factor, NUMA node and target: [l] local [r] provider" << std::endl;)
+        std::cin >> scaleFactor >> numaNode >> target;
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+
+        generateSSBData(scaleFactor, numaNode, target == 'r');
+    };
+
+    auto runSSBLambda = [this]() -> void {
+        char mode;
+        size_t workers;
+        LOG_CONSOLE("[DataCatalog] Run SSB on [l] local [r] remote columns with how many workers?" << std::endl;)
+        std::cin >> mode >> workers;
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+
+        if (mode == 'r') {
+            fetchRemoteInfo();
+        }
+        for (size_t query = 0; query < SSB::QUERY_COUNT; ++query) {
+            auto s_ts = std::chrono::high_resolution_clock::now();
+            const ssb_result_t result = SSB::execute(query, (mode == 'r') ? ssb_mode_t::remote : ssb_mode_t::local, workers);
+            std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - s_ts;
+            LOG_CONSOLE("[SSB] " << SSB::query_name(query) << " in " << secs.count() << " s: " << SSB::result_to_string(result) << std::endl;)
+        }
+    };
+
+    auto loadFileLambda = [this]() -> void {
+        std::string path;
+        std::string ident;
+        char format;
+        LOG_CONSOLE("[DataCatalog] File path, table (csv) or column (binary) name and format: [c] csv [b] binary" << std::endl;)
+        std::cin >> path >> ident >> format;
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+
+        // One type letter per column as for createColumn, e.g. llfd
+        auto toType = [](const char letter) -> col_data_t {
+            switch (letter) {
+                case 's':
+                    return col_data_t::gen_smallint;
+                case 'l':
+                    return col_data_t::gen_bigint;
+                case 'f':
+                    return col_data_t::gen_float;
+                case 'd':
+                    return col_data_t::gen_double;
+                default:
+                    return col_data_t::gen_void;
+            }
+        };
+
+        if (format == 'b') {
+            char dataType;
+            int node;
+            LOG_CONSOLE("Datatype uint8_t [s] uint64_t [l] float [f] double [d] and NUMA node" << std::endl;)
+            std::cin >> dataType >> node;
+            std::cin.clear();
+            std::cin.ignore(10000, '\n');
+            FileLoader::loadBinary(path, ident, toType(dataType), node);
+            return;
+        }
+
+        csv_options_t options;
+        std::string types;
+        char header;
+        LOG_CONSOLE("Delimiter ([t] for tab), header row [y/n], NUMA node and column types (e.g. llfd, - for all uint64_t)" << std::endl;)
+        std::cin >> options.delimiter >> header >> options.node >> types;
+        std::cin.clear();
+        std::cin.ignore(10000, '\n');
+        if (options.delimiter == 't') {
+            options.delimiter = '\t';
+        }
+        options.header = (header == 'y');
+        if (types != "-") {
+            for (auto letter : types) {
+                options.types.push_back(toType(letter));
+                if (options.types.back() == col_data_t::gen_void) {
+                    LOG_ERROR("Incorrect datatype, aborting." << std::endl;)
+                    return;
+                }
+            }
+        }
+        FileLoader::loadCsv(path, ident, options);
+    };
+
+    auto toggleCompressionLambda = [this]() -> void {
+        dataCatalog_compression = !dataCatalog_compression;
+        LOG_INFO("[DataCatalog] Wire compression for served columns is now " << (dataCatalog_compression ? "enabled" : "disabled") << std::endl;)
+    };
+
     TaskManager::getInstance().registerTask(std::make_shared<Task>("createColumn", "[DataCatalog] Create new column", createColLambda));
     TaskManager::getInstance().registerTask(std::make_shared<Task>("printAllColumn", "[DataCatalog] Print all stored columns", [this]() -> void { this->print_all(); this->print_all_remotes(); }));
     TaskManager::getInstance().registerTask(std::make_shared<Task>("printColHead", "[DataCatalog] Print first 10 values of column", printColLambda));
@@ -429,71 +871,128 @@ DataCatalog::DataCatalog() {
     // TaskManager::getInstance().registerTask(std::make_shared<Task>("benchmarkNUMAMTMP", "[DataCatalog] Execute Multi Pipeline MT NUMA", benchQueriesNUMAMT));
     TaskManager::getInstance().registerTask(std::make_shared<Task>("benchmarksAll", "[DataCatalog] Execute All Benchmarks", benchmarksAllLambda));
     TaskManager::getInstance().registerTask(std::make_shared<Task>("itTest", "[DataCatalog] IteratorTest", iteratorTestLambda));
+    TaskManager::getInstance().registerTask(std::make_shared<Task>("toggleAdaptiveChunking", "[DataCatalog] Toggle self-tuning chunk sizes of requested columns", toggleAdaptiveChunkingLambda));
+    TaskManager::getInstance().registerTask(std::make_shared<Task>("toggleDirectReceive", "[DataCatalog] Toggle direct writes into remote column memory", toggleDirectReceiveLambda));
+    TaskManager::getInstance().registerTask(std::make_shared<Task>("toggleCatalogPush", "[DataCatalog] Toggle subscription to pushed catalog updates", toggleCatalogPushLambda));
+    TaskManager::getInstance().registerTask(std::make_shared<Task>("configureStriping", "[DataCatalog] Stripe column requests over several connections", configureStripingLambda));
+    TaskManager::getInstance().registerTask(std::make_shared<Task>("configureRequestQoS", "[DataCatalog] Set request window and priority class weights", configureRequestQoSLambda));
+    TaskManager::getInstance().registerTask(std::make_shared<Task>("configureReceiveBudget", "[DataCatalog] Limit the bytes requested but not yet consumed", configureReceiveBudgetLambda));
+    TaskManager::getInstance().registerTask(std::make_shared<Task>("configurePrefetch", "[DataCatalog] Set the lookahead of planned prefetching", configurePrefetchLambda));
+    TaskManager::getInstance().registerTask(std::make_shared<Task>("openShmChannel", "[DataCatalog] Serve a connection over shared memory with a co-located process", openShmChannelLambda));
+    TaskManager::getInstance().registerTask(std::make_shared<Task>("listenSocket", "[DataCatalog] Serve a connection over TCP (provider side)", listenSocketLambda));
+    TaskManager::getInstance().registerTask(std::make_shared<Task>("connectSocket", "[DataCatalog] Connect to a provider over TCP", connectSocketLambda));
+    TaskManager::getInstance().registerTask(std::make_shared<Task>("addProvider", "[DataCatalog] Add another provider and merge its catalog", addProviderLambda));
+    TaskManager::getInstance().registerTask(std::make_shared<Task>("fetchTable", "[DataCatalog] Stream all columns of a remote table", fetchTableLambda));
+    TaskManager::getInstance().registerTask(std::make_shared<Task>("loadFile", "[DataCatalog] Load a csv file as table or a binary file as column", loadFileLambda));
+    TaskManager::getInstance().registerTask(std::make_shared<Task>("generateSSB", "[DataCatalog] Generate the Star Schema Benchmark tables", generateSSBLambda));
+    TaskManager::getInstance().registerTask(std::make_shared<Task>("runSSB", "[DataCatalog] Run the 13 Star Schema Benchmark queries", runSSBLambda));
+    TaskManager::getInstance().registerTask(std::make_shared<Task>("printConnectionStats", "[DataCatalog] Print per connection transfer statistics", [this]() -> void { this->print_connection_stats(); }));
+    TaskManager::getInstance().registerTask(std::make_shared<Task>("toggleCompression", "[DataCatalog] Toggle wire compression of served columns", toggleCompressionLambda));
+    TaskManager::getInstance().registerTask(std::make_shared<Task>("benchmarkCompression", "[DataCatalog] Verify and measure the wire compression codecs", benchmarkCompressionLambda));
+    TaskManager::getInstance().registerTask(std::make_shared<Task>("benchmarkSelection", "[DataCatalog] Verify and measure the SIMD selection kernels", benchmarkSelectionLambda));
     // TaskManager::getInstance().registerTask(std::make_shared<Task>("pseudoPaxTest", "[DataCatalog] PseudoPaxTest", pseudoPaxLambda));
 
     /* Message Layout
      * [ header_t | payload ]
      * Payload layout
-     * [ columnInfoCount | [col_network_info, identLength, ident]* ]
+     * [ knownVersion, subscribe ]
      */
-    CallbackFunction cb_sendInfo = [this](const size_t conId, const ReceiveBuffer* rcv_buffer, const std::_Bind<ResetFunction(uint64_t)> reset_buffer) -> void {
-        reset_buffer();
-        const uint8_t code = static_cast<uint8_t>(catalog_communication_code::receive_column_info);
-        const size_t columnCount = cols.size();
-
-        size_t totalPayloadSize = sizeof(size_t) + (sizeof(col_network_info) * cols.size());
-        for (auto col : cols) {
-            totalPayloadSize += sizeof(size_t);    // store size of ident length in a 64bit int
-            totalPayloadSize += col.first.size();  // actual c_string
-        }
-        LOG_DEBUG2("[DataCatalog] Callback - allocating " << totalPayloadSize << " for column data." << std::endl;)
-        char* data = reinterpret_cast<char*>(numa_alloc_onnode(totalPayloadSize, 0));
-        char* tmp = data;
+    auto cb_sendInfo = [this](const size_t conId, const auto* rcv_buffer, const auto reset_buffer) -> void {
+        char* data = rcv_buffer->getPayloadBasePtr();
 
-        // How many columns does the receiver need to read
-        memcpy(tmp, &columnCount, sizeof(size_t));
-        tmp += sizeof(size_t);
+        uint64_t known_version;
+        memcpy(&known_version, data, sizeof(uint64_t));
+        data += sizeof(uint64_t);
 
-        for (auto col : cols) {
-            col_network_info cni(col.second->size, col.second->datatype);
-            // Meta data of column, element count and data type
-            memcpy(tmp, &cni, sizeof(cni));
-            tmp += sizeof(cni);
+        bool subscribe;
+        memcpy(&subscribe, data, sizeof(bool));
 
-            // Length of column name
-            size_t identlen = col.first.size();
-            memcpy(tmp, &identlen, sizeof(size_t));
-            tmp += sizeof(size_t);
+        reset_buffer();
 
-            // Actual column name
-            memcpy(tmp, col.first.c_str(), identlen);
-            tmp += identlen;
+        std::lock_guard<std::mutex> lk(catalogVersionLock);
+        if (subscribe && std::find(catalog_subscribers.begin(), catalog_subscribers.end(), conId) == catalog_subscribers.end()) {
+            catalog_subscribers.push_back(conId);
         }
-        ConnectionManager::getInstance().sendData(conId, data, totalPayloadSize, nullptr, 0, code);
-
-        // Release temporary buffer
-        numa_free(reinterpret_cast<void*>(data), totalPayloadSize);
+        sendCatalogDelta(conId, known_version, false);
     };
 
     /* Message Layout
      * [ header_t | payload ]
      * Payload layout
-     * [ columnInfoCount | [col_network_info, identLength, ident]* ]
+     * [ version, isFull, isPush, changeCount | [kind, col_network_info, columnId, identLength, ident]* |
+     *   tableCount | [identLength, ident, numRows, keyColumn, isFactTable, columnCount, [columnId]*]* ]
+     * A full update replaces everything known from the sending provider, otherwise the changes are applied on top of it.
+     * Tables are always sent completely and replace the tables of the sending provider, a table name held by several
+     * providers is served by the first one announcing it.
+     * Column infos of all providers are merged, the placement map keeps track of which providers hold a column.
+     * The column ids are bound per provider, column range messages of the provider are dispatched by indexing its table.
      */
-    CallbackFunction cb_receiveInfo = [this](const size_t conId, const ReceiveBuffer* rcv_buffer, const std::_Bind<ResetFunction(uint64_t)> reset_buffer) -> void {
+    auto cb_receiveInfo = [this](const size_t conId, const auto* rcv_buffer, const auto reset_buffer) -> void {
         char* data = rcv_buffer->getPayloadBasePtr();
 
+        uint64_t version;
+        memcpy(&version, data, sizeof(uint64_t));
+        data += sizeof(uint64_t);
+
+        bool is_full;
+        memcpy(&is_full, data, sizeof(bool));
+        data += sizeof(bool);
+
+        bool is_push;
+        memcpy(&is_push, data, sizeof(bool));
+        data += sizeof(bool);
+
         size_t colCnt;
         memcpy(&colCnt, data, sizeof(size_t));
         data += sizeof(size_t);
         // std::stringstream ss;
-        // ss << "[DataCatalog] Received data for " << colCnt << " columns" << std::endl;
+        // ss << "[DataCatalog] Received " << (is_full ? "full" : "delta") << " catalog version " << version << " with " << colCnt << " changes" << std::endl;
+
+        std::unique_lock<std::mutex> _lkb(remote_info_lock);
+        std::unique_lock<std::mutex> _lkp(placementLock);
+        const std::size_t provider = providerOf(conId);
+        provider_info_t& provider_info = providers[provider];
+        std::vector<std::string> snapshot_idents;
+        // Outdated local copies, retired once the locks are released
+        std::vector<col_t*> replaced_cols;
+
+        // Unbinds the provider's column id of the ident, its messages for that column are discarded from now on
+        auto unbind_column = [&provider_info](const std::string& ident) -> void {
+            auto id_it = provider_info.column_ids.find(ident);
+            if (id_it != provider_info.column_ids.end()) {
+                provider_info.columns[id_it->second].info = nullptr;
+                provider_info.column_ids.erase(id_it);
+            }
+        };
+
+        // Drops the provider from the placement of a column, the column is forgotten once no provider holds it anymore
+        auto remove_placement = [this, provider, &unbind_column](const std::string& ident) -> void {
+            unbind_column(ident);
+            auto placement_it = column_placement.find(ident);
+            if (placement_it == column_placement.end()) {
+                return;
+            }
+            std::erase(placement_it->second, provider);
+            if (placement_it->second.empty()) {
+                column_placement.erase(placement_it);
+                remote_col_info.erase(ident);
+            }
+        };
 
+        catalog_change_kind_t kind;
         col_network_info cni(0, col_data_t::gen_void);
+        col_handle_t column_id;
         size_t identlen;
         for (size_t i = 0; i < colCnt; ++i) {
+            memcpy(&kind, data, sizeof(catalog_change_kind_t));
+            data += sizeof(catalog_change_kind_t);
+
             memcpy(&cni, data, sizeof(cni));
             data += sizeof(cni);
+            cni.received_bytes = 0;
+
+            memcpy(&column_id, data, sizeof(col_handle_t));
+            data += sizeof(col_handle_t);
 
             memcpy(&identlen, data, sizeof(size_t));
             data += sizeof(size_t);
@@ -501,28 +1000,130 @@ DataCatalog::DataCatalog() {
             std::string ident(data, identlen);
             data += identlen;
 
-            std::lock_guard<std::mutex> _lkb(remote_info_lock);
             // ss << "[DataCatalog] Column: " << ident << " - " << cni.size_info << " elements of type " << col_network_info::col_data_type_to_string(cni.type_info) << std::endl;
-            if (!remote_col_info.contains(ident)) {
+            if (kind == catalog_change_kind_t::removed) {
+                remove_placement(ident);
+                continue;
+            }
+
+            snapshot_idents.push_back(ident);
+            auto& placement = column_placement[ident];
+            if (std::find(placement.begin(), placement.end(), provider) == placement.end()) {
+                placement.push_back(provider);
+            }
+
+            auto info_it = remote_col_info.find(ident);
+            if (info_it == remote_col_info.end()) {
                 // ss << "Ident not found!";
-                remote_col_info.insert({ident, cni});
+                info_it = remote_col_info.insert({ident, cni}).first;
                 if (!find_remote(ident)) {
                     add_remote_column(ident, cni);
                 }
+            } else if (placement.size() > 1 && (info_it->second.size_info != cni.size_info || info_it->second.type_info != cni.type_info)) {
+                LOG_WARNING("[DataCatalog] Provider " << provider << " holds column " << ident << " with a different shape than the other providers -- ignoring its copy." << std::endl;)
+                placement.pop_back();
+                unbind_column(ident);
+                continue;
+            } else if (info_it->second.size_info != cni.size_info || info_it->second.type_info != cni.type_info) {
+                // Column was replaced on the remote side, the local copy is outdated. Its readers may still hold it, it is retired instead of freed
+                info_it->second = cni;
+                if (col_t* outdated = remote_cols.erase(ident)) {
+                    replaced_cols.push_back(outdated);
+                }
+            }
+
+            if (column_id == INVALID_COL_HANDLE) {
+                continue;
+            }
+            if (provider_info.columns.size() <= column_id) {
+                provider_info.columns.resize(column_id + 1);
+            }
+            remote_column_ref_t& column = provider_info.columns[column_id];
+            if (column.handle == INVALID_COL_HANDLE) {
+                column.ident = ident;
+                column.handle = remote_cols.handle(ident);
+            }
+            column.info = &info_it->second;
+            provider_info.column_ids[ident] = column_id;
+        }
+
+        if (is_full) {
+            std::sort(snapshot_idents.begin(), snapshot_idents.end());
+            std::vector<std::string> outdated;
+            for (auto& [ident, placement] : column_placement) {
+                if (std::find(placement.begin(), placement.end(), provider) != placement.end() && !std::binary_search(snapshot_idents.begin(), snapshot_idents.end(), ident)) {
+                    outdated.push_back(ident);
+                }
+            }
+            for (auto& ident : outdated) {
+                remove_placement(ident);
+            }
+        }
+
+        std::erase_if(remote_tables, [provider](const auto& table) { return table.second.provider == provider; });
+        size_t tableCnt;
+        memcpy(&tableCnt, data, sizeof(size_t));
+        data += sizeof(size_t);
+        for (size_t i = 0; i < tableCnt; ++i) {
+            remote_table_t table;
+            table.provider = provider;
+
+            memcpy(&identlen, data, sizeof(size_t));
+            data += sizeof(size_t);
+            table.ident = std::string(data, identlen);
+            data += identlen;
+
+            memcpy(&table.numRows, data, sizeof(size_t));
+            data += sizeof(size_t);
+
+            memcpy(&table.keyColumn, data, sizeof(size_t));
+            data += sizeof(size_t);
+
+            memcpy(&table.isFactTable, data, sizeof(bool));
+            data += sizeof(bool);
+
+            size_t columnCnt;
+            memcpy(&columnCnt, data, sizeof(size_t));
+            data += sizeof(size_t);
+
+            bool resolved = true;
+            for (size_t c = 0; c < columnCnt; ++c) {
+                memcpy(&column_id, data, sizeof(col_handle_t));
+                data += sizeof(col_handle_t);
+                if (column_id < provider_info.columns.size() && provider_info.columns[column_id].info != nullptr) {
+                    table.columns.push_back(provider_info.columns[column_id].ident);
+                } else {
+                    resolved = false;
+                }
+            }
+
+            if (!resolved) {
+                LOG_WARNING("[DataCatalog] Provider " << provider << " announced table " << table.ident << " with columns it does not hold -- ignoring table." << std::endl;)
+            } else if (!remote_tables.try_emplace(table.ident, std::move(table)).second) {
+                LOG_DEBUG1("[DataCatalog] Table announced by provider " << provider << " is already served by another provider." << std::endl;)
             }
         }
 
+        provider_info.catalog_version = version;
+        const bool has_remote_columns = !remote_col_info.empty();
+        _lkp.unlock();
+        _lkb.unlock();
+
+        for (auto col : replaced_cols) {
+            retireColumn(col);
+        }
+
         reset_buffer();
 
-        if (colCnt > 0) {
+        if (has_remote_columns) {
             /* Message Layout
              * [ header_t | AppMetaData | payload ]
              * AppMetaData Layout
              * <empty> == 0
              * Payload layout
-             * [ columnNameLength, columnName ]
+             * [ column_request_t ]
              */
-            auto fetchLambda = [this, conId]() -> void {
+            auto fetchLambda = [this]() -> void {
                 print_all_remotes();
                 LOG_CONSOLE("[DataCatalog] Fetch data for which column?" << std::endl;)
                 std::string ident;
@@ -536,6 +1137,7 @@ DataCatalog::DataCatalog() {
                 std::cin.clear();
                 std::cin.ignore(10000, '\n');
 
+                const std::size_t conId = getProviders(ident).front();
                 col_dict_t dict;
                 switch (mode) {
                     case 1: {
@@ -556,236 +1158,273 @@ DataCatalog::DataCatalog() {
             if (!TaskManager::getInstance().hasTask("fetchColDataFromRemote")) {
                 TaskManager::getInstance().registerTask(std::make_shared<Task>("fetchColDataFromRemote", "[DataCatalog] Fetch data from specific remote column", fetchLambda));
             }
+        }
+        if (!is_push) {
             remoteInfoReady();
         }
         // std::cout << ss.str() << std::endl;
     };
 
-    /* Extract column name and prepare sending its data
+    /* Queue sending the whole column
      * Message Layout
      * [ header_t | AppMetaData | payload ]
      * AppMetaData Layout
      * <empty> == 0
      * Payload layout
-     * [ columnNameLength, columnName ]
+     * [ column_request_t ]
      */
-    CallbackFunction cb_fetchCol = [this](const size_t conId, const ReceiveBuffer* rcv_buffer, const std::_Bind<ResetFunction(uint64_t)> reset_buffer) -> void {
-        char* data = rcv_buffer->getPayloadBasePtr();
-
-        size_t identSz;
-        memcpy(&identSz, data, sizeof(size_t));
-        data += sizeof(size_t);
-
-        std::string ident(data, identSz);
-
-        auto col = cols.find(ident);
-
-        // std::cout << "[DataCatalog] Remote requested data for column '" << ident << "' with ident len " << identSz << " and CS " << col->second->calc_checksum() << std::endl;
-
+    auto cb_fetchCol = [this](const size_t conId, const auto* rcv_buffer, const auto reset_buffer) -> void {
+        column_request_t request;
+        memcpy(&request, rcv_buffer->getPayloadBasePtr(), sizeof(column_request_t));
         reset_buffer();
 
-        if (col != cols.end()) {
-            /* Message Layout
-             * [ header_t | ident_len, ident, col_data_type | col_data ]
-             */
-            const size_t appMetaSize = sizeof(size_t) + identSz + sizeof(col_data_t);
-            char* appMetaData = (char*)malloc(appMetaSize);
-            char* tmp = appMetaData;
-
-            memcpy(tmp, &identSz, sizeof(size_t));
-            tmp += sizeof(size_t);
-
-            memcpy(tmp, ident.c_str(), identSz);
-            tmp += identSz;
-
-            memcpy(tmp, &col->second->datatype, sizeof(col_data_t));
-
-            ConnectionManager::getInstance().sendData(conId, (char*)col->second->data, col->second->sizeInBytes, appMetaData, appMetaSize, static_cast<uint8_t>(catalog_communication_code::receive_column_data));
-
-            free(appMetaData);
+        // The whole column is sent from its start, chunk size and offset do not apply
+        request.chunk_size = 0;
+        request.chunk_offset = 0;
+        request.whole_column = true;
+        send_job_t job;
+        if (makeSendJob(conId, request, std::chrono::high_resolution_clock::now(), job)) {
+            enqueueSend(std::move(job));
         }
     };
 
     /* Message Layout
-     * [ header_t | ident_len, ident, col_data_type | col_data ]
+     * [ header_t | column_range_header_t | col_data ]
      */
-    CallbackFunction cb_receiveCol = [this](const size_t conId, const ReceiveBuffer* rcv_buffer, const std::_Bind<ResetFunction(uint64_t)> reset_buffer) -> void {
-        // Package header
-        package_t::header_t* head = reinterpret_cast<package_t::header_t*>(rcv_buffer->getFooterPtr());
-        // Start of AppMetaData
-        char* data = rcv_buffer->getAppMetaPtr();
-        // Actual column data payload
-        char* column_data = rcv_buffer->getPayloadBasePtr();
+    auto cb_receiveCol = [this](const size_t conId, const auto* rcv_buffer, const auto reset_buffer) -> void {
+        receiveColumnMessage(conId, rcv_buffer);
+        reset_buffer();
+    };
 
-        size_t identSz;
-        memcpy(&identSz, data, sizeof(size_t));
-        data += sizeof(size_t);
-
-        std::string ident(data, identSz);
-        data += identSz;
-
-        col_data_t data_type;
-        memcpy(&data_type, data, sizeof(col_data_t));
-
-        // uint64_t* ptr = reinterpret_cast<uint64_t*>(column_data);
-        // // for (size_t i = 0; i < head->current_payload_size / sizeof(uint64_t); ++i) {
-        // //     if (ptr[i] == 0 && ptr[i + 1] == 0 && ptr[i + 2] == 0) {
-        // //         std::cout << ident << "\t" << i << "\t";
-        // //         for (size_t k = 0; k < 10; ++k, ++i) {
-        // //             if (i >= head->current_payload_size / sizeof(uint64_t)) break;
-        // //             std::cout << ptr[i] << "\t";
-        // //         }
-        // //         std::cout << std::endl;
-        // //     }
-        // // }
-        // bool allZero = true;
-        // for (size_t i = 0; i < head->current_payload_size / sizeof(uint64_t); ++i) {
-        //     allZero = allZero && ptr[i] == 0;
-        // }
-
-        // if (allZero) {
-        //     std::cout << "There was a whole Buffer filled with 0 for " << ident << std::endl;
-        // }
+    /* Send a chunk of a column to the requester
+     * Payload layout
+     * [ column_request_t ]
+     * chunk_size is chosen by the requester per request, 0 falls back to dataCatalog_chunkMaxSize.
+     * chunk_offset is set by requesters spreading a column over several replicas, NEXT_CHUNK_OFFSET continues after the last sent chunk.
+     * Chunks are queued per requester by priority and sent by the sender threads, see popSendJob.
+     */
+    auto cb_fetchColChunk = [this](const size_t conId, const auto* rcv_buffer, const auto reset_buffer) -> void {
+        column_request_t request;
+        memcpy(&request, rcv_buffer->getPayloadBasePtr(), sizeof(column_request_t));
+        reset_buffer();
 
-        // std::cout << "Total Message size - header_t: " << sizeof(package_t::header_t) << " AppMetaDataSize: " << head->payload_start << " Payload size: " << head->current_payload_size << " Sum: " << sizeof(package_t::header_t) + head->payload_start + head->current_payload_size << std::endl;
-        // std::cout << "Received data for column: " << ident
-        //           << " of type " << col_network_info::col_data_type_to_string(data_type)
-        //           << ": " << head->current_payload_size
-        //           << " Bytes of " << head->total_data_size
-        //           << " current message offset to Base: " << head->payload_position_offset
-        //           << " AppMetaDataSize: " << head->payload_start << " Bytes"
-        //           << std::endl;
+        request.whole_column = false;
+        send_job_t job;
+        if (makeSendJob(conId, request, std::chrono::high_resolution_clock::now(), job)) {
+            enqueueSend(std::move(job));
+        }
+    };
 
-        std::unique_lock<std::mutex> lk(remote_info_lock);
-        auto col = find_remote(ident);
+    /* Request chunks or whole columns of several columns with a single message
+     * Payload layout
+     * [ entryCount | column_request_t* ]
+     * Every entry is answered exactly like a single fetch_column_data / fetch_column_chunk request.
+     */
+    auto cb_fetchColBatch = [this](const size_t conId, const auto* rcv_buffer, const auto reset_buffer) -> void {
+        char* data = rcv_buffer->getPayloadBasePtr();
 
-        auto col_network_info_iterator = remote_col_info.find(ident);
-        lk.unlock();
+        size_t entryCnt;
+        memcpy(&entryCnt, data, sizeof(size_t));
+        data += sizeof(size_t);
 
-        // Column object already created?
-        if (col == nullptr) {
-            // No Col object, did we even fetch remote info beforehand?
-            if (col_network_info_iterator != remote_col_info.end()) {
-                col = add_remote_column(ident, col_network_info_iterator->second);
-            } else {
-                LOG_WARNING("[DataCatalog] No Network info for received column " << ident << ", fetch column info first -- discarding message" << std::endl;)
-                return;
+        const auto now = std::chrono::high_resolution_clock::now();
+        std::vector<send_job_t> entries;
+        entries.reserve(entryCnt);
+        for (size_t i = 0; i < entryCnt; ++i) {
+            column_request_t request;
+            memcpy(&request, data, sizeof(column_request_t));
+            data += sizeof(column_request_t);
+
+            send_job_t job;
+            if (makeSendJob(conId, request, now, job)) {
+                entries.push_back(std::move(job));
             }
         }
 
-        // Write currently received data to the column object
-        col->append_chunk(head->payload_position_offset, head->current_payload_size, column_data);
-        // Update network info struct to check if we received all data
-        lk.lock();
-        std::lock_guard<std::mutex> lg(col->iteratorLock);
-        col_network_info_iterator->second.received_bytes += head->current_payload_size;
-
-        // std::cout << ident << "\t" << head->package_number << "\t" << head->payload_position_offset << "\t" << head->total_data_size << "\t" << col_network_info_iterator->second.received_bytes << std::endl;
+        reset_buffer();
 
-        if (col_network_info_iterator->second.received_bytes == col->sizeInBytes) {
-            col->is_complete = true;
-            ++col->received_chunks;
-            col->advance_end_pointer(head->total_data_size);
-            // std::cout << "[DataCatalog] Received all data for column: " << ident << std::endl;
+        for (auto& entry : entries) {
+            enqueueSend(std::move(entry));
         }
+    };
 
+    /* Message Layout
+     * [ header_t | column_range_header_t | col_data ]
+     */
+    auto cb_receiveColChunk = [this](const size_t conId, const auto* rcv_buffer, const auto reset_buffer) -> void {
+        // std::cout << "[DataCatalog] Received a message with a (part of a) column chnunk." << std::endl;
+        receiveColumnMessage(conId, rcv_buffer);
         reset_buffer();
     };
 
-    // Send a chunk of a column to the requester
-    CallbackFunction cb_fetchColChunk = [this](const size_t conId, const ReceiveBuffer* rcv_buffer, const std::_Bind<ResetFunction(uint64_t)> reset_buffer) -> void {
+    /* Extract column name and prepare sending its data
+     * Message Layout
+     * [ header_t | col_cnt | [col_ident_size]+ | [col_ident]+ ]
+     */
+    auto cb_fetchPseudoPax = [this](const size_t conId, const auto* rcv_buffer, const auto reset_buffer) -> void {
         // package_t::header_t* head = reinterpret_cast<package_t::header_t*>(rcv_buffer->buf);
         char* data = rcv_buffer->getPayloadBasePtr();
-        // char* column_data = data + head->payload_start;
-
-        size_t identSz;
-        memcpy(&identSz, data, sizeof(size_t));
-        data += sizeof(size_t);
+        size_t* ident_lens = reinterpret_cast<size_t*>(data);
 
-        std::string ident(data, identSz);
+        // Advance data to the first ident character
+        data += (ident_lens[0] + 1) * sizeof(size_t);
 
-        reset_buffer();
+        // Prepare ident vector
+        std::vector<std::string> idents;
+        idents.reserve(ident_lens[0]);
 
-        // std::cout << "Looking for column " << ident << " to send over." << std::endl;
-        inflightLock.lock();
-        auto col_info_it = cols.find(ident);
-
-        // Column is available
-        if (col_info_it != cols.end()) {
-            inflight_col_info_t* info;
-
-            auto inflight_info_it = inflight_cols.find(ident);
-            // No intermediate for requested column. Creating a new entry in the dict.
-            if (inflight_info_it == inflight_cols.end()) {
-                inflight_col_info_t new_info;
-                new_info.col = col_info_it->second;
-                new_info.curr_offset = 0;
-                inflight_cols.insert({ident, new_info});
-                info = &inflight_cols.find(ident)->second;
-            } else {
-                info = &inflight_info_it->second;
-            }
-            inflightLock.unlock();
+        for (size_t i = 0; i < ident_lens[0]; ++i) {
+            idents.emplace_back(data, ident_lens[i + 1]);
+            data += ident_lens[i + 1];
+            // std::cout << "Requesting pseudo pax for " << idents.back() << std::endl;
+        }
 
-            if (info->curr_offset == (info->col)->sizeInBytes) {
-                // std::cout << "[DataCatalog] Column " << ident << " reset offset to 0." << std::endl;
-                info->curr_offset = 0;
-            }
+        reset_buffer();
 
-            /* Message Layout
-             * [ header_t | chunk_offset ident_len, ident, col_data_type | col_data ]
-             */
-            const size_t appMetaSize = sizeof(size_t) + sizeof(size_t) + identSz + sizeof(col_data_t);
-            char* appMetaData = (char*)malloc(appMetaSize);
-            char* tmp = appMetaData;
+        streamPseudoPax(conId, idents, false);
+    };
 
-            // Write chunk offset relative to column start into meta data
-            memcpy(tmp, &info->curr_offset, sizeof(size_t));
-            tmp += sizeof(size_t);
+    /* Stream the requested columns of a table row-aligned, see DataCatalog::fetchTable
+     * Payload layout
+     * [ identLength, ident, priority, columnCount, [columnId]* ]
+     */
+    auto cb_fetchTable = [this](const size_t conId, const auto* rcv_buffer, const auto reset_buffer) -> void {
+        char* data = rcv_buffer->getPayloadBasePtr();
 
-            // Write size of following ident string into meta data
-            memcpy(tmp, &identSz, sizeof(size_t));
-            tmp += sizeof(size_t);
+        size_t identlen;
+        memcpy(&identlen, data, sizeof(size_t));
+        data += sizeof(size_t);
 
-            // Write ident string into meta data
-            memcpy(tmp, ident.c_str(), identSz);
-            tmp += identSz;
+        std::string ident(data, identlen);
+        data += identlen;
 
-            // Append underlying column data type
-            memcpy(tmp, &info->col->datatype, sizeof(col_data_t));
+        request_priority_t priority;
+        memcpy(&priority, data, sizeof(request_priority_t));
+        data += sizeof(request_priority_t);
 
-            const size_t remaining_size = info->col->sizeInBytes - info->curr_offset;
+        size_t columnCnt;
+        memcpy(&columnCnt, data, sizeof(size_t));
+        data += sizeof(size_t);
 
-            const size_t chunk_size = (remaining_size > dataCatalog_chunkMaxSize) ? dataCatalog_chunkMaxSize : remaining_size;
-            char* data_start = static_cast<char*>(info->col->data) + info->curr_offset;
+        std::vector<col_handle_t> column_ids(columnCnt);
+        memcpy(column_ids.data(), data, columnCnt * sizeof(col_handle_t));
 
-            // Increment offset after setting message variables
-            info->curr_offset += chunk_size;
-            // std::cout << "Sent chunk. Offset now: " << info->curr_offset << " Total col size: " << info->col->sizeInBytes << std::endl;
+        reset_buffer();
 
-            ConnectionManager::getInstance().sendData(conId, data_start, chunk_size, appMetaData, appMetaSize, static_cast<uint8_t>(catalog_communication_code::receive_column_chunk));
+        std::vector<std::string> idents;
+        {
+            std::lock_guard<std::mutex> lk(catalogVersionLock);
+            auto table_it = tables.find(ident);
+            if (table_it == tables.end()) {
+                LOG_WARNING("[DataCatalog] Remote requested unknown table " << ident << " -- discarding request." << std::endl;)
+                return;
+            }
+            const auto& table_columns = table_it->second->columns;
+            for (auto column_id : column_ids) {
+                col_t* col = cols.resolve(column_id);
+                if (col == nullptr || std::find(table_columns.begin(), table_columns.end(), col) == table_columns.end()) {
+                    LOG_WARNING("[DataCatalog] Column id " << column_id << " does not belong to table " << ident << " -- discarding request." << std::endl;)
+                    return;
+                }
+                idents.push_back(col->ident);
+            }
+        }
 
-            free(appMetaData);
+        if (!idents.empty()) {
+            streamPseudoPax(conId, idents, true, priority);
         }
-        inflightLock.unlock();
     };
 
     /* Message Layout
-     * [ header_t | chunk_offset ident_len, ident, col_data_type | col_data ]
+     * [ header_t | row_offset row_cnt col_cnt [column_id]+, [bytes_per_column]+ | [payload] ]
      */
-    CallbackFunction cb_receiveColChunk = [this](const size_t conId, const ReceiveBuffer* rcv_buffer, const std::_Bind<ResetFunction(uint64_t)> reset_buffer) -> void {
-        // std::cout << "[DataCatalog] Received a message with a (part of a) column chnunk." << std::endl;
+    auto cb_receivePseudoPax = [this](const size_t conId, const auto* rcv_buffer, const auto reset_buffer) -> void {
         // Package header
         package_t::header_t* head = reinterpret_cast<package_t::header_t*>(rcv_buffer->getFooterPtr());
         // Start of AppMetaData
         char* data = rcv_buffer->getAppMetaPtr();
-        // Actual column data payload
-        char* column_data = rcv_buffer->getPayloadBasePtr();
+        // Start of actual payload
+        char* pax_ptr = rcv_buffer->getPayloadBasePtr();
 
-        size_t chunk_offset;
-        memcpy(&chunk_offset, data, sizeof(size_t));
+        size_t row_offset;
+        memcpy(&row_offset, data, sizeof(size_t));
+        data += sizeof(size_t);
+
+        size_t row_cnt;
+        memcpy(&row_cnt, data, sizeof(size_t));
+        data += sizeof(size_t);
+
+        size_t col_cnt;
+        memcpy(&col_cnt, data, sizeof(size_t));
         data += sizeof(size_t);
 
+        if (row_cnt == 0) {
+            LOG_WARNING("[PseudoPax] Received a message without rows -- discarding message." << std::endl;)
+            reset_buffer();
+            return;
+        }
+
+        // Column ids are resolved in one go, the columns and their network infos stay valid until the provider drops them
+        std::vector<col_t*> remote_cols(col_cnt, nullptr);
+        std::vector<col_network_info*> network_infos(col_cnt, nullptr);
+        {
+            std::lock_guard<std::mutex> lk(remote_info_lock);
+            for (size_t i = 0; i < col_cnt; ++i) {
+                col_handle_t column_id;
+                memcpy(&column_id, data, sizeof(col_handle_t));
+                data += sizeof(col_handle_t);
+
+                const remote_column_ref_t* column = resolveColumnId(conId, column_id);
+                if (column != nullptr) {
+                    remote_cols[i] = resolve_remote(column->handle);
+                    network_infos[i] = column->info;
+                }
+                if (remote_cols[i] == nullptr) {
+                    LOG_WARNING("[PseudoPax] No Network info for received column id " << column_id << ", fetch column info first -- discarding message." << std::endl;)
+                    reset_buffer();
+                    return;
+                }
+            }
+        }
+
+        // bytes_per_column follows the column ids and is not necessarily aligned
+        std::vector<size_t> bytes_per_column(col_cnt);
+        memcpy(bytes_per_column.data(), data, col_cnt * sizeof(size_t));
+
+        for (size_t i = 0; i < remote_cols.size(); ++i) {
+            col_t* col = remote_cols[i];
+
+            // Rows are aligned across columns, the byte offset depends on the element width of each column
+            const size_t column_offset = row_offset * (bytes_per_column[i] / row_cnt);
+            // std::cout << "Current offset for col (" << col << ") " << col->ident << ": " << column_offset << std::endl;
+            col->append_chunk(column_offset, bytes_per_column[i], pax_ptr);
+            pax_ptr += bytes_per_column[i];
+
+            {
+                std::lock_guard<std::mutex> lk(col->iteratorLock);
+                // Update network info struct to check if we received all data
+                network_infos[i]->received_bytes += bytes_per_column[i];
+
+                col->advance_end_pointer(bytes_per_column[i]);
+                if (network_infos[i]->check_complete()) {
+                    col->is_complete = true;
+                    // std::cout << "[PseudoPax] Received all data for column: " << col->ident << std::endl;
+                }
+                ++col->received_chunks;
+            }
+            // Pseudo PAX transfers are driven by fetchPseudoPax, waiting futures must not trigger column chunk requests
+            col->dispatch_ready_ranges(false);
+        }
+
+        reset_buffer();
+    };
+
+    /* Payload layout
+     * [ columnNameLength, columnName, address, size, owner ]
+     */
+    auto cb_announceDirectRegion = [this](const size_t conId, const auto* rcv_buffer, const auto reset_buffer) -> void {
+        char* data = rcv_buffer->getPayloadBasePtr();
+
         size_t identSz;
         memcpy(&identSz, data, sizeof(size_t));
         data += sizeof(size_t);
@@ -793,536 +1432,1555 @@ DataCatalog::DataCatalog() {
         std::string ident(data, identSz);
         data += identSz;
 
-        col_data_t data_type;
-        memcpy(&data_type, data, sizeof(col_data_t));
+        direct_region_t region;
+        memcpy(&region.address, data, sizeof(uint64_t));
+        data += sizeof(uint64_t);
+        memcpy(&region.size, data, sizeof(size_t));
+        data += sizeof(size_t);
+        memcpy(&region.owner, data, sizeof(uint64_t));
 
-        std::unique_lock<std::mutex> lk(remote_info_lock);
-        auto col = find_remote(ident);
+        reset_buffer();
 
-        auto col_network_info_iterator = remote_col_info.find(ident);
-        lk.unlock();
+        std::lock_guard<std::mutex> lk(directRegionLock);
+        direct_regions[ident] = region;
+    };
 
-        // Column object already created?
-        if (col == nullptr) {
-            // No Col object, did we even fetch remote info beforehand?
-            if (col_network_info_iterator != remote_col_info.end()) {
-                col = add_remote_column(ident, col_network_info_iterator->second);
-            } else {
-                LOG_WARNING("[DataCatalog] No Network info for received column " << ident << ", fetch column info first -- discarding message. Current CNI:" << std::endl;)
-                for (auto k : remote_col_info) {
-                    LOG_WARNING(k.first << " " << &k.second << std::endl;)
-                }
-                return;
-            }
-        }
+    auto cb_receiveColReady = [this](const size_t conId, const auto* rcv_buffer, const auto reset_buffer) -> void {
+        receiveColumnReady(conId, rcv_buffer);
+        reset_buffer();
+    };
 
-        /*
-         * chunk_offset / head->total_data_size denotes this is the n^th chunk
-         * head->payload_position_offset describes the position of this message
-         * inside the column chunk, if the buffer was not large enough to send the whole chunk.
-         */
-        const size_t chunk_total_offset = chunk_offset + head->payload_position_offset;
+    auto cb_reconfigureChunkSize = [this](const size_t conId, const auto* rcv_buffer, const auto reset_buffer) -> void {
+        // package_t::header_t* head = reinterpret_cast<package_t::header_t*>(rcv_buffer->buf);
+        char* data = rcv_buffer->getPayloadBasePtr();
 
-        // Write currently received data to the column object
-        col->append_chunk(chunk_total_offset, head->current_payload_size, column_data);
-        // Update network info struct to check if we received all data
-        lk.lock();
-        std::lock_guard<std::mutex> lg(col->iteratorLock);
-        col_network_info_iterator->second.received_bytes += head->current_payload_size;
-        // lk.unlock();
+        uint64_t newChunkSize;
+        memcpy(&newChunkSize, data, sizeof(uint64_t));
+        data += sizeof(uint64_t);
+
+        uint64_t newChunkThreshold;
+        memcpy(&newChunkThreshold, data, sizeof(uint64_t));
 
-        if (col_network_info_iterator->second.received_bytes == col->sizeInBytes) {
-            col->advance_end_pointer(head->total_data_size);
-            col->is_complete = true;
-            ++col->received_chunks;
-            // std::cout << "[DataCatalog] Received all data for column: " << ident << std::endl;
-        } else if (col_network_info_iterator->second.received_bytes % head->total_data_size == 0) {
-            col->advance_end_pointer(head->total_data_size);
-            ++col->received_chunks;
-            // std::cout << "[DataCatalog] Latest chunk of '" << ident << "' received completely." << std::endl;
+        reset_buffer();
+
+        std::lock_guard<std::mutex> lk(reconfigure_lock);
+        if (newChunkSize > 0) {
+            dataCatalog_chunkMaxSize = newChunkSize;
+            dataCatalog_chunkThreshold = newChunkThreshold > 0 ? newChunkThreshold : newChunkSize;
         }
 
+        sendOpCode(conId, static_cast<uint8_t>(catalog_communication_code::ack_reconfigure_chunk_size));
+    };
+
+    auto cb_ackReconfigureChunkSize = [this](const size_t conId, const auto* rcv_buffer, const auto reset_buffer) -> void {
         reset_buffer();
+        std::lock_guard<std::mutex> lk(reconfigure_lock);
+        if (pending_reconfigure_acks > 0 && --pending_reconfigure_acks == 0) {
+            reconfigure_done.notify_all();
+        }
     };
 
-    /* Extract column name and prepare sending its data
-     * Message Layout
-     * [ header_t | col_cnt | [col_ident_size]+ | [col_ident]+ ]
-     */
-    CallbackFunction cb_fetchPseudoPax = [this](const size_t conId, const ReceiveBuffer* rcv_buffer, const std::_Bind<ResetFunction(uint64_t)> reset_buffer) -> void {
-        // package_t::header_t* head = reinterpret_cast<package_t::header_t*>(rcv_buffer->buf);
+    auto cb_generateBenchmarkData = [this](const size_t conId, const auto* rcv_buffer, const auto reset_buffer) -> void {
+        uint64_t data[6];
+        std::memcpy(data, rcv_buffer->getPayloadBasePtr(), sizeof(data));
+        bool createTables = *reinterpret_cast<bool*>(rcv_buffer->getPayloadBasePtr() + sizeof(data));
+        gen_spec_t spec;
+        std::memcpy(&spec, rcv_buffer->getPayloadBasePtr() + sizeof(data) + sizeof(bool), sizeof(gen_spec_t));
+        reset_buffer();
+
+        generateBenchmarkData(data[0], data[1], data[2], data[3], data[4], data[5], false, createTables, spec);
+        // Acknowledged to the requester, several consumers may ask for data
+        sendOpCode(conId, static_cast<uint8_t>(catalog_communication_code::ack_generate_benchmark_data));
+    };
+
+    auto cb_generateSSBData = [this](const size_t conId, const auto* rcv_buffer, const auto reset_buffer) -> void {
+        double scaleFactor;
+        uint64_t numaNode;
         char* data = rcv_buffer->getPayloadBasePtr();
-        size_t* ident_lens = reinterpret_cast<size_t*>(data);
+        std::memcpy(&scaleFactor, data, sizeof(double));
+        std::memcpy(&numaNode, data + sizeof(double), sizeof(uint64_t));
+        reset_buffer();
 
-        // Advance data to the first ident character
-        data += (ident_lens[0] + 1) * sizeof(size_t);
+        SSB::generate(scaleFactor, numaNode);
+        sendOpCode(conId, static_cast<uint8_t>(catalog_communication_code::ack_generate_benchmark_data));
+    };
 
-        // Prepare ident vector
-        std::vector<std::string> idents;
-        idents.reserve(ident_lens[0]);
+    auto cb_ackGenerateBenchmarkData = [this](const size_t conId, const auto* rcv_buffer, const auto reset_buffer) -> void {
+        reset_buffer();
+        std::lock_guard<std::mutex> lk(dataGenerationLock);
+        if (pending_generation_acks > 0 && --pending_generation_acks == 0) {
+            data_generation_done.notify_all();
+        }
+    };
 
-        for (size_t i = 0; i < ident_lens[0]; ++i) {
-            idents.emplace_back(data, ident_lens[i + 1]);
-            data += ident_lens[i + 1];
-            // std::cout << "Requesting pseudo pax for " << idents.back() << std::endl;
+    auto cb_clearCatalog = [this](const size_t conId, const auto* rcv_buffer, const auto reset_buffer) -> void {
+        reset_buffer();
+        DataCatalog::getInstance().clear();
+        sendOpCode(conId, static_cast<uint8_t>(catalog_communication_code::ack_clear_catalog));
+    };
+
+    auto cb_ackClearCatalog = [this](const size_t conId, const auto* rcv_buffer, const auto reset_buffer) -> void {
+        reset_buffer();
+        std::lock_guard<std::mutex> lk(clearCatalogLock);
+        if (pending_clear_acks > 0 && --pending_clear_acks == 0) {
+            clear_catalog_done.notify_all();
+        }
+    };
+
+    registerCallback(static_cast<uint8_t>(catalog_communication_code::send_column_info), cb_sendInfo);
+    registerCallback(static_cast<uint8_t>(catalog_communication_code::receive_column_info), cb_receiveInfo);
+    registerCallback(static_cast<uint8_t>(catalog_communication_code::fetch_column_data), cb_fetchCol);
+    registerCallback(static_cast<uint8_t>(catalog_communication_code::receive_column_data), cb_receiveCol);
+    registerCallback(static_cast<uint8_t>(catalog_communication_code::fetch_column_chunk), cb_fetchColChunk);
+    registerCallback(static_cast<uint8_t>(catalog_communication_code::receive_column_chunk), cb_receiveColChunk);
+    registerCallback(static_cast<uint8_t>(catalog_communication_code::fetch_pseudo_pax), cb_fetchPseudoPax);
+    registerCallback(static_cast<uint8_t>(catalog_communication_code::receive_pseudo_pax), cb_receivePseudoPax);
+    registerCallback(static_cast<uint8_t>(catalog_communication_code::reconfigure_chunk_size), cb_reconfigureChunkSize);
+    registerCallback(static_cast<uint8_t>(catalog_communication_code::ack_reconfigure_chunk_size), cb_ackReconfigureChunkSize);
+    registerCallback(static_cast<uint8_t>(catalog_communication_code::generate_benchmark_data), cb_generateBenchmarkData);
+    registerCallback(static_cast<uint8_t>(catalog_communication_code::ack_generate_benchmark_data), cb_ackGenerateBenchmarkData);
+    registerCallback(static_cast<uint8_t>(catalog_communication_code::clear_catalog), cb_clearCatalog);
+    registerCallback(static_cast<uint8_t>(catalog_communication_code::ack_clear_catalog), cb_ackClearCatalog);
+    registerCallback(static_cast<uint8_t>(catalog_communication_code::announce_direct_region), cb_announceDirectRegion);
+    registerCallback(static_cast<uint8_t>(catalog_communication_code::receive_column_ready), cb_receiveColReady);
+    registerCallback(static_cast<uint8_t>(catalog_communication_code::fetch_column_batch), cb_fetchColBatch);
+    registerCallback(static_cast<uint8_t>(catalog_communication_code::fetch_table), cb_fetchTable);
+    registerCallback(static_cast<uint8_t>(catalog_communication_code::generate_ssb_data), cb_generateSSBData);
+
+    startSenders();
+}
+
+DataCatalog&
+DataCatalog::getInstance() {
+    static DataCatalog instance;
+    return instance;
+}
+
+DataCatalog::~DataCatalog() {
+    // No transport callbacks may run on a catalog being torn down
+    for (auto transport : messageTransports()) {
+        transport->stop();
+    }
+    stopSenders();
+    clear(false, true);
+    delete directWriteTransport;
+}
+
+void DataCatalog::clear(bool sendRemote, bool destructor) {
+    if (sendRemote) {
+        std::lock_guard<std::mutex> lk(clearCatalogLock);
+        for (auto conId : controlConnections()) {
+            ++pending_clear_acks;
+            sendOpCode(conId, static_cast<uint8_t>(catalog_communication_code::clear_catalog));
         }
+    }
 
-        paxInflightLock.lock();
-        bool allPresent = true;
-        // All columns present?
-        std::vector<col_dict_t::iterator> col_its;
-        col_its.reserve(idents.size());
-        size_t total_id_len = 0;
-        for (auto& id : idents) {
-            auto col_info_it = cols.find(id);
-            allPresent &= col_info_it != cols.end();
-            col_its.push_back(col_info_it);
-            total_id_len += id.size();
-            // std::cout << "Column '" << id << "' found? " << ((col_info_it != cols.end()) ? "Yes" : "No") << std::endl;
+    for (auto col : cols.clear()) {
+        delete col;
+    }
+    for (auto col : remote_cols.clear()) {
+        delete col;
+    }
+    freeRetiredColumns();
+
+    {
+        // Same order as cb_receiveInfo, which updates all of them together
+        std::lock_guard<std::mutex> lk(remote_info_lock);
+        std::lock_guard<std::mutex> lkp(placementLock);
+        remote_col_info.clear();
+        column_placement.clear();
+        for (auto& provider : providers) {
+            provider.second.catalog_version = 0;
+            provider.second.columns.clear();
+            provider.second.column_ids.clear();
         }
+        remote_tables.clear();
+    }
 
-        // Build key to identify currently fetched columns - Order Preserving!
-        std::string global_ident;
-        global_ident.reserve(total_id_len + idents.size() - 1);
-        {
-            size_t offset = 0;
-            const char delim = '-';
-            for (size_t i = 0; i < idents.size(); ++i) {
-                const auto& id = idents[i];
-                global_ident += id;
-                if (i < idents.size() - 1) {
-                    global_ident += delim;
-                }
+    tables.clear();
+
+    {
+        std::lock_guard<std::mutex> lk(catalogVersionLock);
+        catalog_journal.clear();
+        catalog_journal_start = ++catalog_version;
+        if (!destructor) {
+            for (auto subscriber : catalog_subscribers) {
+                sendCatalogDelta(subscriber, catalog_version - 1, true);
             }
-        }  // lo_orderdate-lo_quantity-lo_extendedprice
+        }
+    }
 
-        // std::cout << "Global Identifier built: " << global_ident << std::endl;
+    if (!destructor && sendRemote) {
+        std::unique_lock<std::mutex> lk(clearCatalogLock);
+        clear_catalog_done.wait(lk, [this] { return pending_clear_acks == 0; });
+    }
+}
 
-        // All columns are available
-        if (allPresent) {
-            pax_inflight_col_info_t* info;
+template <typename Callback>
+void DataCatalog::registerCallback(uint8_t code, Callback cb) const {
+    if (ConnectionManager::getInstance().registerCallback(code, cb)) {
+        LOG_INFO("[DataCatalog] Successfully added callback for code " << static_cast<uint64_t>(code) << std::endl;)
+    } else {
+        LOG_WARNING("[DataCatalog] Error adding callback for code " << static_cast<uint64_t>(code) << std::endl;)
+    }
 
-            auto inflight_info_it = pax_inflight_cols.find(global_ident);
-            // No intermediate for requested column. Creating a new entry in the dict.
-            if (inflight_info_it == pax_inflight_cols.end()) {
-                pax_inflight_col_info_t* new_info = new pax_inflight_col_info_t();
-                for (auto col_it : col_its) {
-                    new_info->cols.push_back(col_it->second);
-                }
-                pax_inflight_cols.insert({global_ident, new_info});
-                info = new_info;
-            } else {
-                info = inflight_info_it->second;
+    // Messages of the other transports are released when the callback returns, reset_buffer has nothing left to do
+    auto transport_cb = [cb](const size_t conId, const transport_message_t& message) -> void {
+        transport_receive_buffer_t buffer{&message, {}};
+        buffer.footer.id = message.message_id;
+        buffer.footer.total_data_size = message.total_data_size;
+        buffer.footer.current_payload_size = message.payload_size;
+        buffer.footer.package_number = message.package_number;
+        buffer.footer.payload_position_offset = message.payload_position_offset;
+        cb(conId, &buffer, []() -> void {});
+    };
+    for (auto transport : messageTransports()) {
+        if (!transport->registerCallback(code, transport_cb)) {
+            LOG_WARNING("[DataCatalog] Error adding " << transport->name() << " callback for code " << static_cast<uint64_t>(code) << std::endl;)
+        }
+    }
+}
+
+/* Sends an already chosen codec block-wise, each message carries an independently decodable block.
+ * Blocks are cut at multiples of Compression::BLOCK_ELEMENTS so that a block never exceeds a single payload.
+ * Blocks that do not shrink are sent as raw data instead.
+ */
+template <typename T>
+static void sendCompressedBlocks(std::size_t conId, const T* data, const size_t size, const chunk_codec_t codec, column_range_header_t& header, uint8_t code) {
+    char* appMetaData = reinterpret_cast<char*>(&header);
+    const size_t appMetaSize = sizeof(column_range_header_t);
+    const size_t maximumPayloadSize = DataCatalog::getInstance().maxPayloadSize(conId, appMetaSize);
+    const size_t block_elements = ((maximumPayloadSize / sizeof(T)) / Compression::BLOCK_ELEMENTS) * Compression::BLOCK_ELEMENTS;
+    const size_t total_elements = size / sizeof(T);
+
+    // The payload cannot hold a single block, send the range as one raw block that the connection may split
+    if (block_elements == 0) {
+        header.block_offset = 0;
+        header.block_size = size;
+        header.codec = chunk_codec_t::raw;
+        sendMessage(conId, reinterpret_cast<char*>(const_cast<T*>(data)), size, appMetaData, appMetaSize, code);
+        return;
+    }
+
+    char* scratch = reinterpret_cast<char*>(malloc(maximumPayloadSize));
+
+    for (size_t block_start = 0; block_start < total_elements; block_start += block_elements) {
+        const size_t elements = std::min(block_elements, total_elements - block_start);
+        const size_t block_offset = block_start * sizeof(T);
+        const size_t block_size = elements * sizeof(T);
+
+        const size_t compressed_size = Compression::compress<T>(codec, data + block_start, elements, scratch, maximumPayloadSize);
+        const chunk_codec_t block_codec = (compressed_size == 0) ? chunk_codec_t::raw : codec;
+
+        header.block_offset = block_offset;
+        header.block_size = block_size;
+        header.codec = block_codec;
+
+        if (block_codec == chunk_codec_t::raw) {
+            sendMessage(conId, reinterpret_cast<char*>(const_cast<T*>(data + block_start)), block_size, appMetaData, appMetaSize, code);
+        } else {
+            sendMessage(conId, scratch, compressed_size, appMetaData, appMetaSize, code);
+        }
+    }
+
+    free(scratch);
+}
+
+static size_t paxBytesPerRow(const pax_inflight_col_info_t* info) {
+    size_t bytes_per_row = 0;
+    for (auto cur_col : info->cols) {
+        bytes_per_row += col_network_info::col_data_type_width(cur_col->datatype);
+    }
+    return bytes_per_row;
+}
+
+/* Multiples of 8 rows keep every column segment inside a message 8 Byte aligned, regardless of the mixed element widths.
+ * Rows too wide for 8 per message are sent unaligned, 0 if not even a single row fits into the payload.
+ */
+static size_t paxRowsPerMessage(std::size_t conId, const pax_inflight_col_info_t* info) {
+    const size_t maximumPayloadSize = DataCatalog::getInstance().maxPayloadSize(conId, info->metadata_size);
+    const size_t rows = maximumPayloadSize / paxBytesPerRow(info);
+    return (rows < 8) ? rows : (rows / 8) * 8;
+}
+
+/* Fills the ring slots of a stream with one pass over its columns, runs on its own thread started with the first request of a pass.
+ * Each prepared message is handed to a waiting request, otherwise the next request claims it (see streamPseudoPax).
+ */
+void DataCatalog::preparePseudoPax(pax_inflight_col_info_t* info) {
+    const size_t bytes_per_row = paxBytesPerRow(info);
+    const size_t total_rows = info->cols[0]->size;
+    size_t rows_left_to_write = total_rows;
+    const size_t max_rows_per_message = paxRowsPerMessage(info->conId, info);
+
+    // A following pass of the stream reuses the ring, all slots were handed back when the previous pass ended
+    info->offset_lock.lock();
+    if (info->ring_bufs.empty()) {
+        for (size_t slot = 0; slot < pax_inflight_col_info_t::PAX_RING_SIZE; ++slot) {
+            info->ring_bufs.push_back((char*)malloc(max_rows_per_message * bytes_per_row));
+            info->free_slots.push(slot);
+        }
+    }
+    info->offset_lock.unlock();
+
+    // std::cout << "Preparing " << total_rows * bytes_per_row << " Bytes of data" << std::endl;
+    size_t written_bytes = 0;
+
+    while (rows_left_to_write > 0) {
+        // We will always only send 1 message, see maximumPayloadSize.
+        const size_t row_offset = total_rows - rows_left_to_write;
+        const size_t row_cnt = (rows_left_to_write > max_rows_per_message) ? max_rows_per_message : rows_left_to_write;
+        const size_t bytes_in_payload = row_cnt * bytes_per_row;
+
+        // Wait until the sender handed back a staging slot
+        std::unique_lock<std::mutex> slot_lk(info->offset_lock);
+        info->slot_cv.wait(slot_lk, [info] { return !info->free_slots.empty() || info->prepare_aborted; });
+        if (info->prepare_aborted) {
+            return;
+        }
+        const size_t slot = info->free_slots.front();
+        info->free_slots.pop();
+        slot_lk.unlock();
+
+        // std::cout << slot << " " << rows_left_to_write << " " << row_cnt << " " << bytes_in_payload << std::endl;
+
+        char* tmp = info->ring_bufs[slot];
+        for (auto cur_col : info->cols) {
+            const size_t width = col_network_info::col_data_type_width(cur_col->datatype);
+            // std::cout << "Writing " << row_cnt * width << " Bytes for " << cur_col->ident << std::endl;
+            const char* col_data = reinterpret_cast<char*>(cur_col->data) + row_offset * width;
+            memcpy(tmp, col_data, row_cnt * width);
+            tmp += row_cnt * width;
+            written_bytes += row_cnt * width;
+        }
+
+        // Hand the message to a request that is already waiting for it, otherwise the next request claims it
+        bool has_waiting = false;
+        request_priority_t waiting;
+        rows_left_to_write -= row_cnt;
+        slot_lk.lock();
+        info->prepared_offsets.push({slot, bytes_in_payload, row_offset, row_cnt});
+        // Marked with the last message, so its send can end the pass (see end_pass)
+        info->prepare_complete = rows_left_to_write == 0;
+        if (!info->waiting_sends.empty()) {
+            waiting = info->waiting_sends.front();
+            info->waiting_sends.pop();
+            has_waiting = true;
+        } else {
+            ++info->unclaimed;
+        }
+        slot_lk.unlock();
+        if (has_waiting) {
+            enqueuePaxSend(info, waiting);
+        }
+    }
+    // std::cout << "Prepared all messages, written Bytes: " << written_bytes << std::endl;
+}
+
+// Sends the next prepared message of a pseudo PAX pass, runs on a sender thread and never waits for the preparation
+void DataCatalog::sendPreparedPax(pax_inflight_col_info_t* info) {
+    std::unique_lock<std::mutex> lk(info->offset_lock);
+    if (info->prepared_offsets.empty()) {
+        return;
+    }
+    auto pax_chunk = info->prepared_offsets.front();
+    info->prepared_offsets.pop();
+    ++info->sending;
+    lk.unlock();
+
+    char* tmp_meta = (char*)malloc(info->metadata_size);
+    char* tmp = tmp_meta;
+    memcpy(tmp, info->metadata_buf, info->metadata_size);
+
+    memcpy(tmp, &pax_chunk.row_offset, sizeof(size_t));
+    tmp += sizeof(size_t);
+
+    memcpy(tmp, &pax_chunk.row_cnt, sizeof(size_t));
+
+    // Per column byte counts are located at the end of the meta data
+    tmp = tmp_meta + info->metadata_size - info->cols.size() * sizeof(size_t);
+    for (auto cur_col : info->cols) {
+        const size_t bytes_per_column = pax_chunk.row_cnt * col_network_info::col_data_type_width(cur_col->datatype);
+        memcpy(tmp, &bytes_per_column, sizeof(size_t));
+        tmp += sizeof(size_t);
+    }
+
+    // sendData copies the payload, the slot can be refilled right after
+    sendMessage(info->conId, info->ring_bufs[pax_chunk.slot], pax_chunk.payload_size, tmp_meta, info->metadata_size, static_cast<uint8_t>(catalog_communication_code::receive_pseudo_pax));
+    free(tmp_meta);
+    info->release_slot(pax_chunk.slot);
+
+    lk.lock();
+    --info->sending;
+    std::thread* finished = info->end_pass();
+    if (!info->prepare_triggered && !info->waiting_sends.empty()) {
+        // Requests arrived for more messages than the pass had, e.g. a second table stream, they are served by the next pass
+        info->prepare_triggered = true;
+        info->prepare_thread = new std::thread(&DataCatalog::preparePseudoPax, this, info);
+    }
+    lk.unlock();
+    if (finished) {
+        finished->join();
+        delete finished;
+    }
+}
+
+// Queues the send of one prepared message, only called once the message is prepared so the sender never blocks on it
+void DataCatalog::enqueuePaxSend(pax_inflight_col_info_t* info, request_priority_t priority) {
+    send_job_t job{info->conId, info->ident, INVALID_COL_HANDLE, false, 0, 0, priority, std::chrono::high_resolution_clock::now()};
+    job.cost = maxPayloadSize(info->conId, info->metadata_size);
+    job.custom = [this, info]() { sendPreparedPax(info); };
+    enqueueSend(std::move(job));
+}
+
+/* Sends rows of the given columns row-aligned, each message holds the same rows of all columns.
+ * Without whole only the next message is sent, the requester pulls message by message (see fetchPseudoPax).
+ * With whole all messages are queued at once, e.g. to stream a table with a single request.
+ */
+void DataCatalog::streamPseudoPax(std::size_t conId, const std::vector<std::string>& idents, bool whole, request_priority_t priority) {
+    paxInflightLock.lock();
+    bool allPresent = true;
+    // All columns present?
+    std::vector<col_t*> col_its;
+    col_its.reserve(idents.size());
+    size_t total_id_len = 0;
+    for (auto& id : idents) {
+        col_t* col = cols.find(id);
+        allPresent &= col != nullptr;
+        col_its.push_back(col);
+        total_id_len += id.size();
+        // std::cout << "Column '" << id << "' found? " << ((col != nullptr) ? "Yes" : "No") << std::endl;
+    }
+
+    // Rows are aligned across all columns, hence the row counts have to match
+    if (allPresent) {
+        for (auto col_it : col_its) {
+            if (col_it->size != col_its[0]->size) {
+                LOG_WARNING("[DataCatalog] PAX request for columns with different row counts, " << col_it->ident << " has " << col_it->size << " rows, " << col_its[0]->ident << " has " << col_its[0]->size << " -- discarding request." << std::endl;)
+                allPresent = false;
+                break;
             }
-            paxInflightLock.unlock();
+        }
+    }
+
+    // Build key to identify currently fetched columns - Order Preserving!
+    std::string global_ident;
+    global_ident.reserve(total_id_len + idents.size() - 1);
+    {
+        size_t offset = 0;
+        const char delim = '-';
+        for (size_t i = 0; i < idents.size(); ++i) {
+            const auto& id = idents[i];
+            global_ident += id;
+            if (i < idents.size() - 1) {
+                global_ident += delim;
+            }
+        }
+    }  // lo_orderdate-lo_quantity-lo_extendedprice
+
+    // std::cout << "Global Identifier built: " << global_ident << std::endl;
+
+    // Streams of the same columns to different requesters, or pulled and streamed at once, must not share their position
+    const std::string stream_key = global_ident + "@" + std::to_string(conId) + (whole ? "/table" : "/pax");
+
+    // All columns are available
+    if (allPresent) {
+        pax_inflight_col_info_t* info;
 
-            // // Checking first column suffices, all have same length
-            // if (info->curr_offset == (info->cols[0])->sizeInBytes) {
-            //     // std::cout << "[DataCatalog] PAX for " << global_ident << " reset offset to 0." << std::endl;
-            //     info->curr_offset = 0;
-            // }
+        auto inflight_info_it = pax_inflight_cols.find(stream_key);
+        // No intermediate for requested column. Creating a new entry in the dict.
+        if (inflight_info_it == pax_inflight_cols.end()) {
+            pax_inflight_col_info_t* new_info = new pax_inflight_col_info_t();
+            new_info->ident = global_ident;
+            new_info->conId = conId;
+            for (auto col_it : col_its) {
+                new_info->cols.push_back(col_it);
+            }
+            pax_inflight_cols.insert({stream_key, new_info});
+            info = new_info;
+        } else {
+            info = inflight_info_it->second;
+        }
+        paxInflightLock.unlock();
 
-            info->offset_lock.lock();
+        // // Checking first column suffices, all have same length
+        // if (info->curr_offset == (info->cols[0])->sizeInBytes) {
+        //     // std::cout << "[DataCatalog] PAX for " << global_ident << " reset offset to 0." << std::endl;
+        //     info->curr_offset = 0;
+        // }
+
+        /* Setup, triggering the preparation and claiming messages happen under one lock,
+         * the last send of a previous pass may release the staging state concurrently (see end_pass).
+         * A pseudo PAX request is answered with the next message, a streamed request with all messages of the columns.
+         */
+        size_t claimed = 0;
+        {
+            std::lock_guard<std::mutex> lk(info->offset_lock);
             if (info->metadata_size == 0) {
                 /* Message Layout
-                 * [ header_t | chunk_offset bytes_per_column col_cnt [ident_len]+, [ident] | [payload] ]
+                 * [ header_t | row_offset row_cnt col_cnt [column_id]+, [bytes_per_column]+ | [payload] ]
                  */
-                const size_t appMetaSize = 3 * sizeof(size_t) + (sizeof(size_t) * idents.size()) + total_id_len;
-                const size_t ident_metainfo_size = (1 + idents.size()) * sizeof(size_t) + total_id_len;
+                const size_t col_cnt = idents.size();
+                const size_t appMetaSize = 3 * sizeof(size_t) + col_cnt * (sizeof(col_handle_t) + sizeof(size_t));
 
                 // std::cout << "Init info->metadata_buf " << appMetaSize << " Bytes" << std::endl;
                 info->metadata_buf = (char*)malloc(appMetaSize);
                 char* tmp = info->metadata_buf;
-                tmp += sizeof(size_t);  // Placeholder for offset, later.
-                tmp += sizeof(size_t);  // Placeholder for bytes_per_column, later.
-
-                memcpy(tmp, ident_lens, ident_metainfo_size);
-                // std::cout << "Metadata size: " << ident_metainfo_size << std::endl;
-                // for (size_t test = 0; test < idents.size() + 1; ++test) {
-                //     std::cout << "tmp[" << test << "]: " << reinterpret_cast<size_t*>(tmp)[test] << std::endl;
-                // }
+                tmp += sizeof(size_t);  // Placeholder for row_offset, later.
+                tmp += sizeof(size_t);  // Placeholder for row_cnt, later.
+
+                memcpy(tmp, &col_cnt, sizeof(size_t));
+                tmp += sizeof(size_t);
+                for (auto& id : idents) {
+                    const col_handle_t column_id = cols.handle(id);
+                    memcpy(tmp, &column_id, sizeof(col_handle_t));
+                    tmp += sizeof(col_handle_t);
+                }
 
                 info->metadata_size = appMetaSize;
             }
-            info->offset_lock.unlock();
 
-            auto prepare_pax = [](pax_inflight_col_info_t* my_info, size_t conId) -> void {
-                my_info->offset_lock.lock();
-                if (my_info->payload_buf == nullptr) {
-                    my_info->payload_buf = (char*)malloc(my_info->cols[0]->sizeInBytes * my_info->cols.size());
+            if (paxRowsPerMessage(conId, info) == 0) {
+                LOG_ERROR("[PseudoPax] A row of " << global_ident << " (" << paxBytesPerRow(info) << " Bytes) does not fit into a message -- discarding request." << std::endl;)
+                return;
+            }
+
+            if (!info->prepare_triggered) {
+                info->prepare_triggered = true;
+                info->prepare_thread = new std::thread(&DataCatalog::preparePseudoPax, this, info);  // Will be joined when reseting/deleting the info state
+            }
+
+            size_t messages = 1;
+            if (whole) {
+                const size_t rows_per_message = paxRowsPerMessage(conId, info);
+                messages = (info->cols[0]->size + rows_per_message - 1) / rows_per_message;
+            }
+            for (size_t i = 0; i < messages; ++i) {
+                if (info->unclaimed > 0) {
+                    --info->unclaimed;
+                    ++claimed;
                 } else {
-                    my_info->offset_lock.unlock();
-                    return;
+                    info->waiting_sends.push(priority);
                 }
-                my_info->offset_lock.unlock();
+            }
+        }
+        for (size_t i = 0; i < claimed; ++i) {
+            enqueuePaxSend(info, priority);
+        }
+    } else {
+        paxInflightLock.unlock();
+    }
+}
 
-                char* tmp = my_info->payload_buf;
+// Sends the next chunk of a column, the provider keeps track of the current offset per column
+void DataCatalog::sendNextColumnChunk(std::size_t conId, const std::string& ident, col_handle_t column_id, const size_t requested_chunk_size, const size_t requested_offset) {
+    const size_t max_chunk_size = (requested_chunk_size > 0) ? requested_chunk_size : dataCatalog_chunkMaxSize;
 
-                size_t data_left_to_write = my_info->cols[0]->sizeInBytes;
-                size_t curr_col_offset = 0;
-                size_t curr_payload_offset = 0;
+    // std::cout << "Looking for column " << ident << " to send over." << std::endl;
+    std::unique_lock<std::mutex> lk(inflightLock);
+    col_t* col = cols.resolve(column_id);
 
-                using element_type = uint64_t;
-                const size_t maximumPayloadSize = ConnectionManager::getInstance().getConnectionById(conId)->maxBytesInPayload(my_info->metadata_size);
-                const size_t max_bytes_per_column = ((maximumPayloadSize / my_info->cols.size()) / (sizeof(element_type) * 4)) * 4 * sizeof(element_type);
+    // Column is not available
+    if (col == nullptr) {
+        return;
+    }
 
-                // std::cout << "Preparing " << my_info->cols[0]->sizeInBytes * my_info->cols.size() << " Bytes of data" << std::endl;
-                size_t written_bytes = 0;
+    inflight_col_info_t* info;
 
-                while (data_left_to_write > 0) {
-                    // We will always only send 1 message, see maximumPayloadSize. Normalize to 8 Byte members
-                    // We just <know> that we use 64bit values
-                    // TODO: Infer from column data_type member
-                    const size_t bytes_per_column = (data_left_to_write > max_bytes_per_column) ? max_bytes_per_column : data_left_to_write;
-                    const size_t bytes_in_payload = my_info->cols.size() * bytes_per_column;
+    auto inflight_info_it = inflight_cols.find(ident);
+    // No intermediate for requested column. Creating a new entry in the dict.
+    if (inflight_info_it == inflight_cols.end()) {
+        inflight_col_info_t new_info;
+        new_info.col = col;
+        new_info.curr_offset = 0;
+        inflight_cols.insert({ident, new_info});
+        info = &inflight_cols.find(ident)->second;
+    } else {
+        info = &inflight_info_it->second;
+    }
 
-                    // std::cout << curr_payload_offset << " " << data_left_to_write << " " << bytes_per_column << " " << bytes_in_payload << std::endl;
+    if (requested_offset != NEXT_CHUNK_OFFSET) {
+        if (requested_offset >= info->col->sizeInBytes) {
+            LOG_WARNING("[DataCatalog] Requested offset " << requested_offset << " is out of range for column " << ident << " -- ignoring request." << std::endl;)
+            return;
+        }
+        info->curr_offset = requested_offset;
+    } else if (info->curr_offset == (info->col)->sizeInBytes) {
+        // std::cout << "[DataCatalog] Column " << ident << " reset offset to 0." << std::endl;
+        info->curr_offset = 0;
+    }
 
-                    for (auto cur_col : my_info->cols) {
-                        // std::cout << "Writing " << bytes_per_column << " Bytes for " << cur_col->ident << std::endl;
-                        const char* col_data = reinterpret_cast<char*>(cur_col->data) + curr_col_offset;
-                        memcpy(tmp, col_data, bytes_per_column);
-                        tmp += bytes_per_column;
-                        written_bytes += bytes_per_column;
-                    }
+    const size_t remaining_size = info->col->sizeInBytes - info->curr_offset;
+    const size_t chunk_size = (remaining_size > max_chunk_size) ? max_chunk_size : remaining_size;
+    const size_t chunk_offset = info->curr_offset;
 
-                    my_info->offset_lock.lock();
-                    my_info->prepared_offsets.push({curr_payload_offset, bytes_in_payload});
-                    my_info->offset_cv.notify_one();
-                    my_info->offset_lock.unlock();
+    // Increment offset after setting message variables, requests of several connections may arrive concurrently
+    info->curr_offset += chunk_size;
+    // std::cout << "Sent chunk. Offset now: " << info->curr_offset << " Total col size: " << info->col->sizeInBytes << std::endl;
+    lk.unlock();
 
-                    curr_col_offset += bytes_per_column;
-                    curr_payload_offset += bytes_per_column * my_info->cols.size();
-                    data_left_to_write -= bytes_per_column;
-                }
-                my_info->offset_lock.lock();
-                my_info->prepare_complete = true;
-                my_info->offset_lock.unlock();
-                // std::cout << "Prepared all messages, written Bytes: " << written_bytes << std::endl;
-            };
+    sendColumnRange(conId, info->col, ident, column_id, chunk_offset, chunk_size, catalog_communication_code::receive_column_chunk);
+}
 
-            info->offset_lock.lock();
-            if (!info->prepare_triggered) {
-                info->prepare_triggered = true;
-                info->prepare_thread = new std::thread(prepare_pax, info, conId);  // Will be joined when reseting/deleting the info state
+/* Message Layout
+ * [ header_t | column_range_header_t | col_data ]
+ * Raw ranges are sent as a single block and may be split by the connection, compressed ranges as one block per message.
+ */
+void DataCatalog::sendColumnRange(std::size_t conId, const col_t* col, const std::string& ident, col_handle_t column_id, const size_t offset, const size_t size, catalog_communication_code code) const {
+    // Block information is filled per message
+    column_range_header_t header{offset, size, 0, size, column_id, chunk_codec_t::raw, col->datatype};
+    char* appMetaData = reinterpret_cast<char*>(&header);
+    const size_t appMetaSize = sizeof(column_range_header_t);
+
+    char* data_start = reinterpret_cast<char*>(col->data) + offset;
+
+    // The consumer announced the memory of its column, write directly and only send the readiness information
+    if (directWriteTransport != nullptr) {
+        std::unique_lock<std::mutex> lk(directRegionLock);
+        auto region_it = direct_regions.find(ident);
+        if (region_it != direct_regions.end()) {
+            const direct_region_t region = region_it->second;
+            lk.unlock();
+            if (directWriteTransport->write(region, offset, data_start, size)) {
+                sendMessage(conId, appMetaData, appMetaSize, nullptr, 0, static_cast<uint8_t>(catalog_communication_code::receive_column_ready));
+                return;
             }
-            info->offset_lock.unlock();
+        }
+    }
 
-            reset_buffer();
+    chunk_codec_t codec = chunk_codec_t::raw;
+    if (dataCatalog_compression) {
+        switch (col->datatype) {
+            case col_data_t::gen_smallint: {
+                codec = Compression::choose_codec<uint8_t>(reinterpret_cast<uint8_t*>(data_start), size / sizeof(uint8_t)).codec;
+            } break;
+            case col_data_t::gen_bigint: {
+                codec = Compression::choose_codec<uint64_t>(reinterpret_cast<uint64_t*>(data_start), size / sizeof(uint64_t)).codec;
+            } break;
+            default:
+                break;
+        }
+    }
 
-            std::unique_lock<std::mutex> lk(info->offset_lock);
-            info->offset_cv.wait(lk, [info] { return !info->prepared_offsets.empty(); });
-            // Semantically we want to "unlock" after waiting, yet this is a performance gain to not do it.
-            // lk.unlock();
-            // lk.lock();
-            auto offset_size_pair = info->prepared_offsets.front();
-            info->prepared_offsets.pop();
-            lk.unlock();
+    if (codec == chunk_codec_t::raw) {
+        sendMessage(conId, data_start, size, appMetaData, appMetaSize, static_cast<uint8_t>(code));
+    } else if (col->datatype == col_data_t::gen_smallint) {
+        sendCompressedBlocks<uint8_t>(conId, reinterpret_cast<uint8_t*>(data_start), size, codec, header, static_cast<uint8_t>(code));
+    } else {
+        sendCompressedBlocks<uint64_t>(conId, reinterpret_cast<uint64_t*>(data_start), size, codec, header, static_cast<uint8_t>(code));
+    }
+}
 
-            char* tmp_meta = (char*)malloc(info->metadata_size);
-            char* tmp = tmp_meta;
-            memcpy(tmp, info->metadata_buf, info->metadata_size);
+static column_range_header_t parseColumnRangeHeader(const char* data) {
+    column_range_header_t header;
+    memcpy(&header, data, sizeof(column_range_header_t));
+    return header;
+}
 
-            memcpy(tmp, &offset_size_pair.first, sizeof(size_t));
-            tmp += sizeof(size_t);
+template <typename Buffer>
+bool DataCatalog::receiveColumnMessage(std::size_t conId, const Buffer* rcv_buffer) {
+    // Package header
+    package_t::header_t* head = reinterpret_cast<package_t::header_t*>(rcv_buffer->getFooterPtr());
+    // Actual column data payload
+    char* column_data = rcv_buffer->getPayloadBasePtr();
 
-            const size_t bpc = offset_size_pair.second / info->cols.size();  // Normalize to bytes per column because pair contains total payload size
-            memcpy(tmp, &bpc, sizeof(size_t));
-            tmp += sizeof(size_t);
+    const column_range_header_t meta = parseColumnRangeHeader(rcv_buffer->getAppMetaPtr());
 
-            ConnectionManager::getInstance().sendData(conId, info->payload_buf + offset_size_pair.first, offset_size_pair.second, tmp_meta, info->metadata_size, static_cast<uint8_t>(catalog_communication_code::receive_pseudo_pax));
-            free(tmp_meta);
-            if (info->prepare_complete && info->prepared_offsets.empty()) {
-                info->reset();
-            }
-        } else {
-            reset_buffer();
-        }
-        paxInflightLock.unlock();
-    };
+    std::unique_lock<std::mutex> lk(remote_info_lock);
+    const remote_column_ref_t* column = resolveColumnId(conId, meta.column_id);
+    if (column == nullptr) {
+        LOG_WARNING("[DataCatalog] No Network info for received column id " << meta.column_id << " on connection " << conId << ", fetch column info first -- discarding message." << std::endl;)
+        return false;
+    }
+    auto col = remote_cols.resolve(column->handle);
+    // Column object already created?
+    if (col == nullptr) {
+        const std::string ident = column->ident;
+        const col_network_info info = *column->info;
+        lk.unlock();
+        col = add_remote_column(ident, info);
+    } else {
+        lk.unlock();
+    }
 
-    /* Message Layout
-     * [ header_t | chunk_offset bytes_per_column col_cnt [ident_len]+, [ident] | [payload] ]
+    // Messages sent before the provider republished the column with another shape may not fit the current one
+    const size_t message_bytes = (meta.codec == chunk_codec_t::raw) ? head->current_payload_size : meta.block_size;
+    const size_t message_offset = meta.chunk_offset + meta.block_offset + ((meta.codec == chunk_codec_t::raw) ? head->payload_position_offset : 0);
+    if (message_offset + message_bytes > col->sizeInBytes) {
+        LOG_WARNING("[DataCatalog] Received range of column " << col->ident << " exceeds its size, the column was replaced -- discarding message." << std::endl;)
+        return false;
+    }
+
+    /*
+     * For raw blocks head->payload_position_offset describes the position of this message inside the block,
+     * if the buffer was not large enough to send the whole block. Compressed blocks always fit a single message.
      */
-    CallbackFunction cb_receivePseudoPax = [this](const size_t conId, const ReceiveBuffer* rcv_buffer, const std::_Bind<ResetFunction(uint64_t)> reset_buffer) -> void {
-        // Package header
-        package_t::header_t* head = reinterpret_cast<package_t::header_t*>(rcv_buffer->getFooterPtr());
-        // Start of AppMetaData
-        char* data = rcv_buffer->getAppMetaPtr();
-        // Start of actual payload
-        char* pax_ptr = rcv_buffer->getPayloadBasePtr();
+    size_t received_bytes;
+    if (meta.codec == chunk_codec_t::raw) {
+        received_bytes = head->current_payload_size;
+        col->append_chunk(meta.chunk_offset + meta.block_offset + head->payload_position_offset, received_bytes, column_data);
+    } else {
+        received_bytes = meta.block_size;
+        if (!col->append_compressed_chunk(meta.chunk_offset + meta.block_offset, meta.block_size, meta.codec, column_data, head->current_payload_size)) {
+            LOG_ERROR("[DataCatalog] Failed to decode " << Compression::codec_to_string(meta.codec) << " block of column " << col->ident << " -- discarding message." << std::endl;)
+            return false;
+        }
+    }
 
-        size_t chunk_offset;
-        memcpy(&chunk_offset, data, sizeof(size_t));
-        data += sizeof(size_t);
+    accountReceived(conId, received_bytes);
 
-        size_t bytes_per_column;
-        memcpy(&bytes_per_column, data, sizeof(size_t));
-        data += sizeof(size_t);
+    // Update network info struct to check if we received all data, the provider may have dropped or replaced the column meanwhile
+    lk.lock();
+    column = resolveColumnId(conId, meta.column_id);
+    if (column != nullptr && remote_cols.resolve(column->handle) == col) {
+        std::lock_guard<std::mutex> lg(col->iteratorLock);
+        completeColumnRange(col, *column->info, meta.chunk_offset, meta.chunk_size, received_bytes);
+    }
+    lk.unlock();
+    col->dispatch_ready_ranges();
 
-        // Advance data to the first ident character
-        size_t* ident_infos = reinterpret_cast<size_t*>(data);
-        data += (ident_infos[0] + 1) * sizeof(size_t);
+    return true;
+}
 
-        // Prepare ident vector
-        std::vector<std::string> idents;
-        idents.reserve(ident_infos[0]);
+/* Message Layout
+ * [ header_t | column_range_header_t ]
+ * The data was already written into the announced region of the column, only the bookkeeping is left.
+ */
+template <typename Buffer>
+bool DataCatalog::receiveColumnReady(std::size_t conId, const Buffer* rcv_buffer) {
+    const column_range_header_t meta = parseColumnRangeHeader(rcv_buffer->getPayloadBasePtr());
+    accountReceived(conId, meta.block_size);
 
-        // std::cout << "[PseudoPax] message with " << bytes_per_column << " bytes per column for columns: " << std::flush;
-        for (size_t i = 0; i < ident_infos[0]; ++i) {
-            idents.emplace_back(data, ident_infos[i + 1]);
-            data += ident_infos[i + 1];
-            // std::cout << idents.back() << " ";
-        }
-        // std::cout << std::endl;
+    std::unique_lock<std::mutex> lk(remote_info_lock);
+    const remote_column_ref_t* column = resolveColumnId(conId, meta.column_id);
+    col_t* col = (column != nullptr) ? remote_cols.resolve(column->handle) : nullptr;
 
-        std::vector<col_t*> remote_cols;
-        remote_cols.reserve(idents.size());
-        bool allPresent = true;
-        for (auto& id : idents) {
-            auto remote_col_it = find_remote(id);
-            allPresent &= remote_col_it != nullptr;
-            remote_cols.push_back(remote_col_it);
-        }
+    if (col == nullptr) {
+        LOG_WARNING("[DataCatalog] Direct write finished for unknown column id " << meta.column_id << " on connection " << conId << " -- discarding message." << std::endl;)
+        return false;
+    }
 
-        for (auto col : remote_cols) {
-            auto col_network_info_iterator = remote_col_info.find(col->ident);
-            if (col_network_info_iterator == remote_col_info.end()) {
-                // std::cout << "[PseudoPax] No Network info for received column " << col->ident << ", fetch column info first -- discarding message" << std::endl;
-                return;
-            }
+    {
+        std::lock_guard<std::mutex> lg(col->iteratorLock);
+        completeColumnRange(col, *column->info, meta.chunk_offset, meta.chunk_size, meta.block_size);
+    }
+    lk.unlock();
+    col->dispatch_ready_ranges();
 
-            const size_t current_offset = col_network_info_iterator->second.received_bytes;
-            // std::cout << "Current offset for col (" << col << ") " << col->ident << ": " << current_offset << std::endl;
-            col->append_chunk(current_offset, bytes_per_column, pax_ptr);
-            pax_ptr += bytes_per_column;
+    return true;
+}
 
-            std::lock_guard<std::mutex> lk(col->iteratorLock);
-            // Update network info struct to check if we received all data
-            col_network_info_iterator->second.received_bytes += bytes_per_column;
+/* Chunks may complete in any order when requests are striped over several connections,
+ * the column only becomes readable up to the first chunk that is still missing.
+ * Expects remote_info_lock and col->iteratorLock to be held by the caller.
+ */
+void DataCatalog::completeColumnRange(col_t* col, col_network_info& network_info, const size_t chunk_offset, const size_t chunk_size, const size_t received_bytes) {
+    network_info.received_bytes += received_bytes;
+
+    auto progress_it = col->chunk_progress.try_emplace(chunk_offset, 0).first;
+    progress_it->second += received_bytes;
+    if (progress_it->second < chunk_size) {
+        return;
+    }
+    col->chunk_progress.erase(progress_it);
+
+    col->complete_chunk(chunk_offset, chunk_size);
+    std::chrono::high_resolution_clock::time_point requested_at;
+    col->received_chunks += col->settle_requests(chunk_offset, chunk_size, requested_at);
+    if (network_info.received_bytes == col->sizeInBytes) {
+        col->is_complete = true;
+        // std::cout << "[DataCatalog] Received all data for column: " << col->ident << std::endl;
+    } else {
+        col->chunk_tuner.on_chunk_received(chunk_size, requested_at);
+        // std::cout << "[DataCatalog] Latest chunk of '" << col->ident << "' received completely." << std::endl;
+    }
+}
+
+// Registers a provider reachable over the given connections, the first one carries catalog messages
+void DataCatalog::addProvider(const std::vector<std::size_t>& connections) {
+    std::lock_guard<std::mutex> lk(placementLock);
+    const std::size_t primary = connections.front();
+    auto& provider = providers[primary];
+    provider.connections = connections;
+    for (auto conId : connections) {
+        connection_provider[conId] = primary;
+    }
+}
+
+// Registers conId as a provider unless it already belongs to one and fetches its catalog
+void DataCatalog::connectProvider(std::size_t conId) {
+    bool known_provider;
+    {
+        std::lock_guard<std::mutex> lk(placementLock);
+        known_provider = providers.find(conId) != providers.end() || connection_provider.find(conId) != connection_provider.end();
+    }
+    if (!known_provider) {
+        addProvider({conId});
+    }
+    fetchRemoteInfo();
+}
+
+// Connections carrying the control messages of all providers, the single peer on connection 1 if no provider was added
+std::vector<std::size_t> DataCatalog::controlConnections() const {
+    std::lock_guard<std::mutex> lk(placementLock);
+    std::vector<std::size_t> result;
+    for (auto& provider : providers) {
+        result.push_back(provider.first);
+    }
+    if (result.empty()) {
+        result.push_back(1);
+    }
+    return result;
+}
+
+// Providers holding the column, all known providers if the column was not announced by any of them yet
+std::vector<std::size_t> DataCatalog::getProviders(const std::string& ident) const {
+    std::lock_guard<std::mutex> lk(placementLock);
+    auto placement_it = column_placement.find(ident);
+    if (placement_it != column_placement.end()) {
+        return placement_it->second;
+    }
+    std::vector<std::size_t> result;
+    for (auto& provider : providers) {
+        result.push_back(provider.first);
+    }
+    return result;
+}
+
+// Expects placementLock to be held by the caller
+std::size_t DataCatalog::providerOf(std::size_t conId) const {
+    auto it = connection_provider.find(conId);
+    return (it != connection_provider.end()) ? it->second : conId;
+}
+
+/* Looks up a column id announced by the provider of the connection, nullptr if the provider does not hold such a column.
+ * Expects remote_info_lock to be held by the caller, the entry is only valid as long as it is held.
+ */
+const remote_column_ref_t* DataCatalog::resolveColumnId(std::size_t conId, col_handle_t column_id) const {
+    std::lock_guard<std::mutex> lk(placementLock);
+    auto provider_it = providers.find(providerOf(conId));
+    if (provider_it == providers.end() || column_id >= provider_it->second.columns.size()) {
+        return nullptr;
+    }
+    const remote_column_ref_t& column = provider_it->second.columns[column_id];
+    return (column.info != nullptr) ? &column : nullptr;
+}
+
+// Id the provider of the connection announced for the column, INVALID_COL_HANDLE if it did not announce it
+col_handle_t DataCatalog::columnIdOf(std::size_t conId, const std::string& ident) const {
+    std::lock_guard<std::mutex> lk(placementLock);
+    auto provider_it = providers.find(providerOf(conId));
+    if (provider_it == providers.end()) {
+        return INVALID_COL_HANDLE;
+    }
+    auto id_it = provider_it->second.column_ids.find(ident);
+    return (id_it != provider_it->second.column_ids.end()) ? id_it->second : INVALID_COL_HANDLE;
+}
+
+// Provider side: resolves the column id of a request, requests for ids this catalog never announced are dropped
+bool DataCatalog::makeSendJob(std::size_t conId, const column_request_t& request, std::chrono::_V2::system_clock::time_point enqueued, send_job_t& job) const {
+    col_t* col = cols.resolve(request.column_id);
+    if (col == nullptr) {
+        LOG_WARNING("[DataCatalog] Request of connection " << conId << " for unknown column id " << request.column_id << " -- discarding request." << std::endl;)
+        return false;
+    }
+    job = send_job_t{conId, col->ident, request.column_id, request.whole_column, request.chunk_size, request.chunk_offset, request.priority, enqueued};
+    return true;
+}
 
-            col->advance_end_pointer(bytes_per_column);
-            if (col_network_info_iterator->second.check_complete()) {
-                col->is_complete = true;
-                // std::cout << "[PseudoPax] Received all data for column: " << col->ident << std::endl;
+/* Picks the replica of the column with the lowest load and, within it, the connection with the fewest outstanding bytes.
+ * The load of a provider is the expected time to drain its outstanding bytes at its measured throughput.
+ * As long as a candidate has no throughput measurement yet, the outstanding bytes are compared directly.
+ * Ties are broken round-robin.
+ */
+std::size_t DataCatalog::scheduleConnection(const std::string& ident, const size_t bytes) {
+    std::vector<std::vector<std::size_t>> candidates;
+    {
+        std::lock_guard<std::mutex> lk(placementLock);
+        auto placement_it = column_placement.find(ident);
+        if (placement_it != column_placement.end()) {
+            for (auto provider : placement_it->second) {
+                auto provider_it = providers.find(provider);
+                if (provider_it != providers.end() && !provider_it->second.connections.empty()) {
+                    candidates.push_back(provider_it->second.connections);
+                }
             }
-            ++col->received_chunks;
+        } else if (!providers.empty() && !providers.begin()->second.connections.empty()) {
+            candidates.push_back(providers.begin()->second.connections);
         }
+    }
+    if (candidates.empty()) {
+        candidates.push_back({1});
+    }
 
-        reset_buffer();
-    };
+    std::lock_guard<std::mutex> lk(connectionStatsLock);
+    std::vector<provider_load_t> loads;
+    loads.reserve(candidates.size());
+    bool all_measured = true;
+    for (auto& connections : candidates) {
+        provider_load_t load;
+        for (auto conId : connections) {
+            const auto& stats = connection_stats[conId];
+            load.outstanding_bytes += stats.outstanding_bytes();
+            load.throughput += stats.throughput();
+        }
+        all_measured &= load.throughput > 0;
+        loads.push_back(load);
+    }
 
-    CallbackFunction cb_reconfigureChunkSize = [this](const size_t conId, const ReceiveBuffer* rcv_buffer, const std::_Bind<ResetFunction(uint64_t)> reset_buffer) -> void {
-        // package_t::header_t* head = reinterpret_cast<package_t::header_t*>(rcv_buffer->buf);
-        char* data = rcv_buffer->getPayloadBasePtr();
+    const size_t candidateCount = candidates.size();
+    size_t best_provider = next_connection % candidateCount;
+    for (size_t i = 1; i < candidateCount; ++i) {
+        const size_t candidate = (next_connection + i) % candidateCount;
+        const bool less_loaded = all_measured ? loads[candidate].drain_time() < loads[best_provider].drain_time() : loads[candidate].outstanding_bytes < loads[best_provider].outstanding_bytes;
+        if (less_loaded) {
+            best_provider = candidate;
+        }
+    }
 
-        uint64_t newChunkSize;
-        memcpy(&newChunkSize, data, sizeof(uint64_t));
-        data += sizeof(uint64_t);
+    const auto& connections = candidates[best_provider];
+    const size_t connectionCount = connections.size();
+    std::size_t best = connections[next_connection % connectionCount];
+    size_t best_outstanding = connection_stats[best].outstanding_bytes();
+    for (size_t i = 1; i < connectionCount; ++i) {
+        const std::size_t candidate = connections[(next_connection + i) % connectionCount];
+        const size_t outstanding = connection_stats[candidate].outstanding_bytes();
+        if (outstanding < best_outstanding) {
+            best = candidate;
+            best_outstanding = outstanding;
+        }
+    }
+    ++next_connection;
 
-        uint64_t newChunkThreshold;
-        memcpy(&newChunkThreshold, data, sizeof(uint64_t));
+    auto& stats = connection_stats[best];
+    ++stats.requests;
+    stats.requested_bytes += bytes;
+    return best;
+}
 
-        reset_buffer();
+/* Takes bytes from the receive budget for a request of col. Without enough budget the column is parked until releaseBudget.
+ * A column holding no budget is always admitted: scans often wait for one column before consuming another,
+ * so every column keeps at least one request in flight and the budget only limits the read-ahead beyond it.
+ * Called with col->iteratorLock held.
+ */
+bool DataCatalog::acquireBudget(col_t* col, const size_t bytes, bool fetch_complete_column) {
+    std::lock_guard<std::mutex> lk(budgetLock);
+    if (dataCatalog_receiveBudget == 0 || budget_in_use + bytes <= dataCatalog_receiveBudget || col->budget_held == 0) {
+        budget_in_use += bytes;
+        return true;
+    }
+    if (std::find_if(budget_waiters.begin(), budget_waiters.end(), [col](const auto& waiter) { return waiter.first == col; }) == budget_waiters.end()) {
+        budget_waiters.emplace_back(col, fetch_complete_column);
+    }
+    return false;
+}
 
-        std::lock_guard<std::mutex> lk(reconfigure_lock);
-        if (newChunkSize > 0) {
-            dataCatalog_chunkMaxSize = newChunkSize;
-            dataCatalog_chunkThreshold = newChunkThreshold > 0 ? newChunkThreshold : newChunkSize;
+/* Gives budget back and lets the parked columns try again, must not be called with a column's iteratorLock held.
+ * Waiters are taken one at a time and marked as dispatching, so a column deleted meanwhile is not requested for (see forgetBudget).
+ * Only the columns parked on entry are tried, a column parking again waits for the next release.
+ */
+void DataCatalog::releaseBudget(const size_t bytes) {
+    std::unique_lock<std::mutex> lk(budgetLock);
+    budget_in_use = (budget_in_use > bytes) ? budget_in_use - bytes : 0;
+    for (size_t parked = budget_waiters.size(); parked > 0 && !budget_waiters.empty(); --parked) {
+        const auto [col, fetch_complete_column] = budget_waiters.front();
+        budget_waiters.erase(budget_waiters.begin());
+        budget_dispatching.push_back(col);
+        lk.unlock();
+
+        col->request_data(fetch_complete_column);
+
+        lk.lock();
+        budget_dispatching.erase(std::find(budget_dispatching.begin(), budget_dispatching.end(), col));
+        budget_dispatch_cv.notify_all();
+    }
+}
+
+/* Takes a remote column replaced on the provider out of service without freeing it, readers may still hold it.
+ * Waiting futures fail, stalled iterators stop and no further requests are sent for it. Must be called without holding catalog locks.
+ */
+void DataCatalog::retireColumn(col_t* col) {
+    std::multimap<size_t, std::shared_ptr<RangeFuture::state_t>> waiters;
+    size_t held;
+    {
+        std::lock_guard<std::mutex> lk(col->iteratorLock);
+        col->retired = true;
+        held = col->budget_held;
+        col->budget_held = 0;
+        waiters.swap(col->range_waiters);
+        col->iterator_data_available.notify_all();
+    }
+    for (auto& waiter : waiters) {
+        RangeFuture::complete(waiter.second, false);
+    }
+    forgetBudget(col, 0);
+    releaseBudget(held);
+
+    std::lock_guard<std::mutex> lk(retiredLock);
+    retired_cols.push_back(col);
+}
+
+void DataCatalog::freeRetiredColumns() {
+    std::vector<col_t*> retired;
+    {
+        std::lock_guard<std::mutex> lk(retiredLock);
+        retired.swap(retired_cols);
+    }
+    for (auto col : retired) {
+        delete col;
+    }
+}
+
+/* A remote column is deleted, its budget is returned without waking anyone up.
+ * Returns once no releaseBudget requests for col anymore, so the caller may free it. Must not be called with a lock held that requesting data takes, e.g. placementLock.
+ */
+void DataCatalog::forgetBudget(col_t* col, const size_t held_bytes) {
+    std::unique_lock<std::mutex> lk(budgetLock);
+    budget_in_use = (budget_in_use > held_bytes) ? budget_in_use - held_bytes : 0;
+    std::erase_if(budget_waiters, [col](const auto& waiter) { return waiter.first == col; });
+    budget_dispatch_cv.wait(lk, [this, col] { return std::find(budget_dispatching.begin(), budget_dispatching.end(), col) == budget_dispatching.end(); });
+}
+
+/* Sends the request right away if its connection has less than dataCatalog_requestWindow bytes in flight and nothing queued,
+ * otherwise it waits in the weighted fair queue of the connection until enough data arrived.
+ */
+void DataCatalog::submitRequest(std::size_t conId, std::string& ident, bool whole_column, size_t chunk_size, size_t chunk_offset, request_priority_t priority) {
+    const size_t cls = static_cast<size_t>(priority);
+    {
+        std::lock_guard<std::mutex> lk(connectionStatsLock);
+        auto& stats = connection_stats[conId];
+        auto& priority_stats = request_priority_stats[cls];
+        ++priority_stats.requests;
+        priority_stats.bytes += chunk_size;
+
+        auto queue_it = request_queues.try_emplace(conId, PRIORITY_CLASSES).first;
+        if (dataCatalog_requestWindow > 0 && (!queue_it->second.empty() || stats.inflight_bytes() >= dataCatalog_requestWindow)) {
+            queue_it->second.push(cls, chunk_size, dataCatalog_priorityWeights[cls], queued_request_t{ident, whole_column, chunk_size, chunk_offset, priority, std::chrono::high_resolution_clock::now()});
+            return;
+        }
+        stats.sent_bytes += chunk_size;
+    }
+    fetchColStub(conId, ident, whole_column, chunk_size, chunk_offset, priority);
+}
+
+// Sends queued requests of the connection, highest weighted share first, until its window is full again
+void DataCatalog::releaseQueuedRequests(std::size_t conId) {
+    for (;;) {
+        queued_request_t request;
+        {
+            std::lock_guard<std::mutex> lk(connectionStatsLock);
+            auto queue_it = request_queues.find(conId);
+            auto& stats = connection_stats[conId];
+            if (queue_it == request_queues.end() || queue_it->second.empty() || (dataCatalog_requestWindow > 0 && stats.inflight_bytes() >= dataCatalog_requestWindow)) {
+                return;
+            }
+            request = queue_it->second.pop();
+            stats.sent_bytes += request.chunk_size;
+            request_priority_stats[static_cast<size_t>(request.priority)].record_wait(std::chrono::high_resolution_clock::now() - request.enqueued);
+        }
+        fetchColStub(conId, request.ident, request.whole_column, request.chunk_size, request.chunk_offset, request.priority);
+    }
+}
+
+void DataCatalog::accountReceived(std::size_t conId, const size_t bytes) {
+    const auto now = std::chrono::high_resolution_clock::now();
+    {
+        std::lock_guard<std::mutex> lk(connectionStatsLock);
+        auto& stats = connection_stats[conId];
+        if (stats.received_bytes == 0) {
+            stats.first_receive = now;
+        }
+        stats.received_bytes += bytes;
+        stats.last_receive = now;
+    }
+    releaseQueuedRequests(conId);
+}
+
+/* Provider side: chunk jobs are costed with the bytes they will send, whole columns with the column size.
+ * A chunk request starting right where a queued request of the same requester, column and priority ends is merged into it.
+ */
+void DataCatalog::enqueueSend(send_job_t job) {
+    if (job.cost == 0) {
+        job.cost = (job.chunk_size > 0) ? job.chunk_size : dataCatalog_chunkMaxSize;
+        if (job.whole_column) {
+            col_t* col = cols.resolve(job.column_id);
+            job.cost = (col != nullptr) ? col->sizeInBytes : 0;
+        }
+    }
+    const size_t cls = static_cast<size_t>(job.priority);
+    const std::size_t requester = job.conId;
+
+    std::unique_lock<std::mutex> lk(sendQueueLock);
+    auto& priority_stats = send_priority_stats[cls];
+    ++priority_stats.requests;
+    priority_stats.bytes += job.cost;
+
+    const bool mergeable = !job.custom && !job.whole_column && job.chunk_offset != NEXT_CHUNK_OFFSET && job.chunk_size > 0;
+    const auto tail_key = std::make_pair(requester, job.ident);
+    if (mergeable) {
+        auto tail_it = send_tails.find(tail_key);
+        if (tail_it != send_tails.end()) {
+            auto& tail = *tail_it->second;
+            if (tail.priority == job.priority && tail.chunk_offset + tail.chunk_size == job.chunk_offset && tail.chunk_size + job.chunk_size <= dataCatalog_coalesceLimit) {
+                tail.chunk_size += job.chunk_size;
+                tail.cost += job.cost;
+                ++coalesced_requests;
+                return;
+            }
         }
+    }
 
-        ConnectionManager::getInstance().sendOpCode(1, static_cast<uint8_t>(catalog_communication_code::ack_reconfigure_chunk_size), true);
-    };
+    auto queued = std::make_shared<send_job_t>(std::move(job));
+    if (mergeable) {
+        send_tails[tail_key] = queued;
+    }
+    auto queue_it = send_queues.try_emplace(requester, PRIORITY_CLASSES).first;
+    const bool was_idle = queue_it->second.empty() && !requester_busy[requester];
+    queue_it->second.push(cls, queued->cost, dataCatalog_priorityWeights[cls], queued);
+    if (was_idle) {
+        active_requesters.push_back(requester);
+        lk.unlock();
+        send_queue_cv.notify_one();
+    }
+}
 
-    CallbackFunction cb_ackReconfigureChunkSize = [this](const size_t conId, const ReceiveBuffer* rcv_buffer, const std::_Bind<ResetFunction(uint64_t)> reset_buffer) -> void {
-        reset_buffer();
-        std::lock_guard<std::mutex> lk(reconfigure_lock);
-        reconfigured = true;
-        reconfigure_done.notify_all();
-    };
+/* Deficit round robin over the backlogged requesters with a quantum of dataCatalog_chunkMaxSize bytes.
+ * The chosen requester leaves active_requesters until its job was sent, so its messages are never sent concurrently.
+ * Expects sendQueueLock to be held and active_requesters to be non-empty.
+ */
+std::shared_ptr<send_job_t> DataCatalog::popSendJob() {
+    const size_t quantum = (dataCatalog_chunkMaxSize > 0) ? dataCatalog_chunkMaxSize : 1;
+    for (;;) {
+        const std::size_t requester = active_requesters.front();
+        auto& queue = send_queues[requester];
+        auto& deficit = send_deficit[requester];
+        const size_t cost = queue.top()->cost;
+
+        if (active_requesters.size() > 1 && deficit < cost) {
+            deficit += quantum;
+            active_requesters.pop_front();
+            active_requesters.push_back(requester);
+            continue;
+        }
 
-    CallbackFunction cb_generateBenchmarkData = [this](const size_t conId, const ReceiveBuffer* rcv_buffer, const std::_Bind<ResetFunction(uint64_t)> reset_buffer) -> void {
-        uint64_t* data = reinterpret_cast<uint64_t*>(rcv_buffer->getPayloadBasePtr());
-        bool createTables = *reinterpret_cast<bool*>(reinterpret_cast<char*>(data) + (sizeof(uint64_t) * 6));
+        auto job = queue.pop();
+        deficit = (queue.empty() || deficit < cost) ? 0 : deficit - cost;
+        active_requesters.pop_front();
+        requester_busy[requester] = true;
 
-        generateBenchmarkData(data[0], data[1], data[2], data[3], data[4], data[5], false, createTables);
-        reset_buffer();
-    };
+        auto tail_it = send_tails.find(std::make_pair(requester, job->ident));
+        if (tail_it != send_tails.end() && tail_it->second == job) {
+            send_tails.erase(tail_it);
+        }
+        return job;
+    }
+}
 
-    CallbackFunction cb_ackGenerateBenchmarkData = [this](const size_t conId, const ReceiveBuffer* rcv_buffer, const std::_Bind<ResetFunction(uint64_t)> reset_buffer) -> void {
-        reset_buffer();
-        std::lock_guard<std::mutex> lk(dataGenerationLock);
-        dataGenerationDone = true;
-        data_generation_done.notify_all();
-    };
+void DataCatalog::executeSendJob(const send_job_t& job) {
+    if (job.custom) {
+        job.custom();
+    } else if (job.whole_column) {
+        col_t* col = cols.resolve(job.column_id);
+        if (col != nullptr) {
+            sendColumnRange(job.conId, col, job.ident, job.column_id, 0, col->sizeInBytes, catalog_communication_code::receive_column_data);
+        }
+    } else {
+        sendNextColumnChunk(job.conId, job.ident, job.column_id, job.chunk_size, job.chunk_offset);
+    }
+}
 
-    CallbackFunction cb_clearCatalog = [this](const size_t conId, const ReceiveBuffer* rcv_buffer, const std::_Bind<ResetFunction(uint64_t)> reset_buffer) -> void {
-        reset_buffer();
-        DataCatalog::getInstance().clear();
-    };
+void DataCatalog::runSender() {
+    std::unique_lock<std::mutex> lk(sendQueueLock);
+    for (;;) {
+        send_queue_cv.wait(lk, [this] { return !active_requesters.empty() || !senders_running; });
+        if (!senders_running) {
+            return;
+        }
 
-    CallbackFunction cb_ackClearCatalog = [this](const size_t conId, const ReceiveBuffer* rcv_buffer, const std::_Bind<ResetFunction(uint64_t)> reset_buffer) -> void {
-        reset_buffer();
-        std::lock_guard<std::mutex> lk(clearCatalogLock);
-        clearCatalogDone = true;
-        clear_catalog_done.notify_all();
-    };
+        auto job = popSendJob();
+        send_priority_stats[static_cast<size_t>(job->priority)].record_wait(std::chrono::high_resolution_clock::now() - job->enqueued);
+        lk.unlock();
 
-    registerCallback(static_cast<uint8_t>(catalog_communication_code::send_column_info), cb_sendInfo);
-    registerCallback(static_cast<uint8_t>(catalog_communication_code::receive_column_info), cb_receiveInfo);
-    registerCallback(static_cast<uint8_t>(catalog_communication_code::fetch_column_data), cb_fetchCol);
-    registerCallback(static_cast<uint8_t>(catalog_communication_code::receive_column_data), cb_receiveCol);
-    registerCallback(static_cast<uint8_t>(catalog_communication_code::fetch_column_chunk), cb_fetchColChunk);
-    registerCallback(static_cast<uint8_t>(catalog_communication_code::receive_column_chunk), cb_receiveColChunk);
-    registerCallback(static_cast<uint8_t>(catalog_communication_code::fetch_pseudo_pax), cb_fetchPseudoPax);
-    registerCallback(static_cast<uint8_t>(catalog_communication_code::receive_pseudo_pax), cb_receivePseudoPax);
-    registerCallback(static_cast<uint8_t>(catalog_communication_code::reconfigure_chunk_size), cb_reconfigureChunkSize);
-    registerCallback(static_cast<uint8_t>(catalog_communication_code::ack_reconfigure_chunk_size), cb_ackReconfigureChunkSize);
-    registerCallback(static_cast<uint8_t>(catalog_communication_code::generate_benchmark_data), cb_generateBenchmarkData);
-    registerCallback(static_cast<uint8_t>(catalog_communication_code::ack_generate_benchmark_data), cb_ackGenerateBenchmarkData);
-    registerCallback(static_cast<uint8_t>(catalog_communication_code::clear_catalog), cb_clearCatalog);
-    registerCallback(static_cast<uint8_t>(catalog_communication_code::ack_clear_catalog), cb_ackClearCatalog);
-}
+        executeSendJob(*job);
 
-DataCatalog&
-DataCatalog::getInstance() {
-    static DataCatalog instance;
-    return instance;
+        lk.lock();
+        requester_busy[job->conId] = false;
+        if (!send_queues[job->conId].empty()) {
+            active_requesters.push_back(job->conId);
+            send_queue_cv.notify_one();
+        }
+    }
 }
 
-DataCatalog::~DataCatalog() {
-    clear(false, true);
+void DataCatalog::startSenders() {
+    std::lock_guard<std::mutex> lk(sendQueueLock);
+    if (senders_running) {
+        return;
+    }
+    senders_running = true;
+    const size_t senderCount = (dataCatalog_senderThreads > 0) ? dataCatalog_senderThreads : 1;
+    for (size_t i = 0; i < senderCount; ++i) {
+        sender_threads.emplace_back(&DataCatalog::runSender, this);
+    }
 }
 
-void DataCatalog::clear(bool sendRemote, bool destructor) {
-    if (sendRemote) {
-        ConnectionManager::getInstance().sendOpCode(1, static_cast<uint8_t>(catalog_communication_code::clear_catalog), true);
+// Jobs still queued are dropped, a running job is finished first
+void DataCatalog::stopSenders() {
+    {
+        std::lock_guard<std::mutex> lk(sendQueueLock);
+        if (!senders_running) {
+            return;
+        }
+        senders_running = false;
+    }
+    send_queue_cv.notify_all();
+    for (auto& sender : sender_threads) {
+        sender.join();
     }
+    sender_threads.clear();
+
+    std::lock_guard<std::mutex> lk(sendQueueLock);
+    send_queues.clear();
+    active_requesters.clear();
+    send_deficit.clear();
+    requester_busy.clear();
+    send_tails.clear();
+}
 
-    for (auto it : cols) {
-        delete it.second;
+void DataCatalog::print_connection_stats() const {
+    std::stringstream ss;
+    {
+        std::lock_guard<std::mutex> lk(connectionStatsLock);
+        ss << "[DataCatalog] Connection statistics (stripe width " << dataCatalog_stripeWidth << ", request window " << dataCatalog_requestWindow << " Bytes)" << std::endl;
+        for (auto& [conId, stats] : connection_stats) {
+            auto queue_it = request_queues.find(conId);
+            const size_t queued = (queue_it != request_queues.end()) ? queue_it->second.size() : 0;
+            ss << "\t" << conId << "\tRequests: " << stats.requests << "\tRequested: " << stats.requested_bytes << " Bytes\tReceived: " << stats.received_bytes << " Bytes\tOutstanding: " << stats.outstanding_bytes() << " Bytes\tQueued: " << queued << "\tThroughput: " << stats.throughput() << " GiB/s" << std::endl;
+        }
+        {
+            std::lock_guard<std::mutex> lkb(budgetLock);
+            ss << "[DataCatalog] Receive budget: " << budget_in_use << " of " << dataCatalog_receiveBudget << " Bytes in use, " << budget_waiters.size() << " columns waiting" << std::endl;
+        }
+        ss << "[DataCatalog] Requests per priority class" << std::endl;
+        for (size_t cls = 0; cls < PRIORITY_CLASSES; ++cls) {
+            auto& stats = request_priority_stats[cls];
+            ss << "\t" << request_priority_to_string(static_cast<request_priority_t>(cls)) << "\tRequests: " << stats.requests << "\tRequested: " << stats.bytes << " Bytes\tQueued: " << stats.queued << "\tAvg. wait: " << (stats.queued > 0 ? stats.queue_wait.count() / stats.queued : 0) << " s\tMax. wait: " << stats.max_queue_wait.count() << " s" << std::endl;
+        }
     }
-    cols.clear();
-    for (auto it : remote_cols) {
-        delete it.second;
+    {
+        std::lock_guard<std::mutex> lk(sendQueueLock);
+        ss << "[DataCatalog] Sends per priority class (" << sender_threads.size() << " sender threads, " << coalesced_requests << " requests merged into adjacent ones)" << std::endl;
+        for (size_t cls = 0; cls < PRIORITY_CLASSES; ++cls) {
+            auto& stats = send_priority_stats[cls];
+            ss << "\t" << request_priority_to_string(static_cast<request_priority_t>(cls)) << "\tJobs: " << stats.requests << "\tBytes: " << stats.bytes << "\tAvg. wait: " << (stats.queued > 0 ? stats.queue_wait.count() / stats.queued : 0) << " s\tMax. wait: " << stats.max_queue_wait.count() << " s" << std::endl;
+        }
     }
-    remote_cols.clear();
-
-    remote_col_info.clear();
-
-    tables.clear();
+    LOG_INFO(ss.str();)
+}
 
-    if (!destructor && sendRemote) {
-        std::unique_lock<std::mutex> lk(clearCatalogLock);
-        if (!clearCatalogDone) {
-            clear_catalog_done.wait(lk, [this] { return clearCatalogDone; });
+// Value ranges of columns generated without a spec
+static gen_spec_t defaultGenSpec(col_data_t type) {
+    gen_spec_t spec;
+    switch (type) {
+        case col_data_t::gen_smallint: {
+            spec.upper = 99;
+            break;
+        }
+        case col_data_t::gen_bigint: {
+            spec.upper = 100;
+            break;
+        }
+        default: {
+            spec.upper = 50;
+            break;
         }
-    } else if (!destructor) {
-        ConnectionManager::getInstance().sendOpCode(1, static_cast<uint8_t>(catalog_communication_code::ack_clear_catalog), true);
     }
+    return spec;
 }
 
-void DataCatalog::registerCallback(uint8_t code, CallbackFunction cb) const {
-    if (ConnectionManager::getInstance().registerCallback(code, cb)) {
-        LOG_INFO("[DataCatalog] Successfully added callback for code " << static_cast<uint64_t>(code) << std::endl;)
-    } else {
-        LOG_WARNING("[DataCatalog] Error adding callback for code " << static_cast<uint64_t>(code) << std::endl;)
+template <typename T>
+static bool generateInto(col_t* col, size_t elemCount, int node, const gen_spec_t& spec, const col_t* source) {
+    col->allocate_on_numa<T>(elemCount, node);
+    if (!DataGenerator::fill(reinterpret_cast<T*>(col->data), elemCount, spec, static_cast<uint32_t>(std::hash<std::string>{}(col->ident)), source ? static_cast<const T*>(source->data) : nullptr)) {
+        return false;
     }
+    col->readableOffset = elemCount * sizeof(T);
+    return true;
+}
+
+col_t* DataCatalog::generate(std::string ident, col_data_t type, size_t elemCount, int node) {
+    return generate(ident, type, elemCount, node, defaultGenSpec(type));
 }
 
-col_dict_t::iterator DataCatalog::generate(std::string ident, col_data_t type, size_t elemCount, int node) {
-    auto it = cols.find(ident);
+col_t* DataCatalog::generate(std::string ident, col_data_t type, size_t elemCount, int node, const gen_spec_t& spec, const std::string& source) {
+    col_t* present = cols.find(ident);
 
-    if (it != cols.end()) {
+    if (present != nullptr) {
         LOG_INFO("Column width ident " << ident << " already present, returning old data." << std::endl;)
-        return it;
+        return present;
+    }
+
+    const col_t* source_col = nullptr;
+    if (spec.distribution == gen_distribution_t::correlated) {
+        source_col = cols.find(source);
+        if (source_col == nullptr || !source_col->is_complete || source_col->datatype != type || source_col->size < elemCount) {
+            LOG_ERROR("[DataCatalog] Correlated column " << ident << " needs a complete local source column of the same type with at least " << elemCount << " elements, " << source << " does not qualify." << std::endl;)
+            return nullptr;
+        }
     }
 
     col_t* tmp = new col_t();
     tmp->ident = ident;
     tmp->size = elemCount;
+    tmp->datatype = type;
 
-    std::default_random_engine generator;
+    bool generated = false;
     switch (type) {
         case col_data_t::gen_smallint: {
-            std::uniform_int_distribution<uint8_t> distribution(0, 99);
-            tmp->datatype = col_data_t::gen_smallint;
-            tmp->allocate_on_numa<uint8_t>(elemCount, node);
-            auto data = reinterpret_cast<uint8_t*>(tmp->data);
-            for (size_t i = 0; i < elemCount; ++i) {
-                data[i] = distribution(generator);
-            }
-            tmp->readableOffset = elemCount * sizeof(uint8_t);
+            generated = generateInto<uint8_t>(tmp, elemCount, node, spec, source_col);
             break;
         }
         case col_data_t::gen_bigint: {
-            std::uniform_int_distribution<uint64_t> distribution(0, 100);
-            tmp->datatype = col_data_t::gen_bigint;
-            tmp->allocate_on_numa<uint64_t>(elemCount, node);
-            auto data = reinterpret_cast<uint64_t*>(tmp->data);
-            for (size_t i = 0; i < elemCount; ++i) {
-                data[i] = distribution(generator);
-            }
-            tmp->readableOffset = elemCount * sizeof(uint64_t);
+            generated = generateInto<uint64_t>(tmp, elemCount, node, spec, source_col);
             break;
         }
         case col_data_t::gen_float: {
-            std::uniform_real_distribution<float> distribution(0, 50);
-            tmp->datatype = col_data_t::gen_float;
-            tmp->allocate_on_numa<float>(elemCount, node);
-            auto data = reinterpret_cast<float*>(tmp->data);
-            for (size_t i = 0; i < elemCount; ++i) {
-                data[i] = distribution(generator);
-            }
-            tmp->readableOffset = elemCount * sizeof(float);
+            generated = generateInto<float>(tmp, elemCount, node, spec, source_col);
             break;
         }
         case col_data_t::gen_double: {
-            std::uniform_real_distribution<double> distribution(0, 50);
-            tmp->datatype = col_data_t::gen_double;
-            tmp->allocate_on_numa<double>(elemCount, node);
-            auto data = reinterpret_cast<double*>(tmp->data);
-            for (size_t i = 0; i < elemCount; ++i) {
-                data[i] = distribution(generator);
-            }
-            tmp->readableOffset = elemCount * sizeof(double);
+            generated = generateInto<double>(tmp, elemCount, node, spec, source_col);
+            break;
+        }
+        default: {
             break;
         }
     }
+    if (!generated) {
+        LOG_ERROR("[DataCatalog] Could not generate column " << ident << " with " << DataGenerator::distribution_to_string(spec.distribution) << " values in [" << spec.lower << ", " << spec.upper << "]." << std::endl;)
+        delete tmp;
+        return nullptr;
+    }
     tmp->is_remote = false;
     tmp->is_complete = true;
-    cols.insert({ident, tmp});
+    // A concurrent generate of the same ident may have won the race, its column is kept
+    auto inserted = cols.insert(ident, tmp);
+    if (!inserted.second) {
+        delete tmp;
+        return inserted.first;
+    }
+    recordCatalogChange(catalog_change_kind_t::added, ident, tmp);
+    return tmp;
+}
+
+col_t* DataCatalog::find_local(const std::string& ident) const {
     return cols.find(ident);
 }
 
-col_t* DataCatalog::find_local(std::string ident) const {
-    auto it = cols.find(ident);
-    if (it != cols.end()) {
-        return (*it).second;
+col_t* DataCatalog::find_remote(const std::string& ident) const {
+    return remote_cols.find(ident);
+}
+
+col_handle_t DataCatalog::local_handle(const std::string& ident) {
+    return cols.handle(ident);
+}
+
+col_handle_t DataCatalog::remote_handle(const std::string& ident) {
+    return remote_cols.handle(ident);
+}
+
+col_t* DataCatalog::resolve_local(const col_handle_t handle) const {
+    return cols.resolve(handle);
+}
+
+col_t* DataCatalog::resolve_remote(const col_handle_t handle) const {
+    return remote_cols.resolve(handle);
+}
+
+col_t* DataCatalog::add_column(std::string ident, col_t* col) {
+    auto inserted = cols.insert(ident, col);
+    if (inserted.second) {
+        recordCatalogChange(catalog_change_kind_t::added, ident, col);
+    }
+    return inserted.first;
+}
+
+// Takes a local column out of the catalog and announces its removal, the caller owns the returned column
+col_t* DataCatalog::remove_column(const std::string& ident) {
+    col_t* col = cols.erase(ident);
+    if (col != nullptr) {
+        recordCatalogChange(catalog_change_kind_t::removed, ident, col);
     }
-    return nullptr;
+    return col;
 }
 
-col_t* DataCatalog::find_remote(std::string ident) const {
-    std::lock_guard<std::mutex> l(appendLock);
-    auto it = remote_cols.find(ident);
-    if (it != remote_cols.end()) {
-        return (*it).second;
+/* Adds a local table and announces it, its columns have to be in the catalog already (see table_t).
+ * Returns false if a table of the same ident is present, the caller keeps the ownership of the table then.
+ */
+bool DataCatalog::add_table(table_t* table) {
+    std::lock_guard<std::mutex> lk(catalogVersionLock);
+    if (!tables.insert({table->ident, table}).second) {
+        LOG_WARNING("[DataCatalog] Table with same ident ('" << table->ident << "') already present, cannot add table." << std::endl;)
+        return false;
     }
-    return nullptr;
+    // Tables are not journaled, every catalog message carries all of them
+    ++catalog_version;
+    for (auto subscriber : catalog_subscribers) {
+        sendCatalogDelta(subscriber, catalog_version - 1, true);
+    }
+    return true;
 }
 
-col_t* DataCatalog::add_column(std::string ident, col_t* col) {
-    return cols.insert({ident, col}).first->second;
+// Only a hint for skipping work, a concurrent add_table may still win afterwards
+bool DataCatalog::has_table(const std::string& ident) const {
+    std::lock_guard<std::mutex> lk(catalogVersionLock);
+    return tables.contains(ident);
+}
+
+// Journals a change of the local catalog and pushes it to all subscribed consumers
+void DataCatalog::recordCatalogChange(catalog_change_kind_t kind, const std::string& ident, const col_t* col) {
+    // The handle of the ident doubles as its column id on the wire, it stays the same if the column is replaced
+    const col_handle_t column_id = cols.handle(ident);
+    std::lock_guard<std::mutex> lk(catalogVersionLock);
+    catalog_journal.push_back({++catalog_version, kind, ident, col_network_info(col->size, col->datatype), column_id});
+    // Compaction, the dropped changes are only needed by consumers that are that far behind, they fall back to a full sync
+    while (catalog_journal.size() > CATALOG_JOURNAL_LIMIT) {
+        catalog_journal.pop_front();
+        catalog_journal_start = catalog_journal.front().version - 1;
+    }
+    for (auto subscriber : catalog_subscribers) {
+        sendCatalogDelta(subscriber, catalog_version - 1, true);
+    }
+}
+
+/* Sends all changes after known_version, or the whole catalog if the journal does not reach back that far.
+ * Expects catalogVersionLock to be held by the caller.
+ * Payload layout
+ * [ version, isFull, isPush, changeCount | [kind, col_network_info, columnId, identLength, ident]* |
+ *   tableCount | [identLength, ident, numRows, keyColumn, isFactTable, columnCount, [columnId]*]* ]
+ * The consumer names the column by columnId in all following requests and this provider does so in all column range messages.
+ * The table schemas are few and always sent completely, they replace the tables known from this provider.
+ */
+void DataCatalog::sendCatalogDelta(std::size_t conId, uint64_t known_version, bool is_push) const {
+    const bool is_full = known_version < catalog_journal_start || known_version > catalog_version;
+
+    std::vector<catalog_change_t> changes;
+    if (is_full) {
+        changes.reserve(cols.size());
+        cols.for_each([&](const std::string& ident, col_t* col) {
+            changes.push_back({catalog_version, catalog_change_kind_t::added, ident, col_network_info(col->size, col->datatype), cols.find_handle(ident)});
+        });
+    } else {
+        // The journal is ordered by version, only its tail is newer than known_version
+        auto newer = std::partition_point(catalog_journal.begin(), catalog_journal.end(), [known_version](const catalog_change_t& change) { return change.version <= known_version; });
+        changes.assign(newer, catalog_journal.end());
+    }
+
+    // Only tables whose columns are all part of the catalog can be announced
+    std::vector<std::pair<const table_t*, std::vector<col_handle_t>>> announced_tables;
+    for (auto& [name, table] : tables) {
+        std::vector<col_handle_t> column_ids;
+        for (auto col : table->columns) {
+            const col_handle_t column_id = cols.find_handle(col->ident);
+            if (column_id == INVALID_COL_HANDLE || cols.resolve(column_id) != col) {
+                break;
+            }
+            column_ids.push_back(column_id);
+        }
+        if (!column_ids.empty() && column_ids.size() == table->columns.size()) {
+            announced_tables.emplace_back(table, std::move(column_ids));
+        }
+    }
+
+    size_t totalPayloadSize = sizeof(uint64_t) + 2 * sizeof(bool) + sizeof(size_t);
+    for (auto& change : changes) {
+        totalPayloadSize += sizeof(catalog_change_kind_t) + sizeof(col_network_info) + sizeof(col_handle_t) + sizeof(size_t) + change.ident.size();
+    }
+    totalPayloadSize += sizeof(size_t);
+    for (auto& [table, column_ids] : announced_tables) {
+        totalPayloadSize += sizeof(size_t) + table->ident.size() + 2 * sizeof(size_t) + sizeof(bool) + sizeof(size_t) + column_ids.size() * sizeof(col_handle_t);
+    }
+    LOG_DEBUG2("[DataCatalog] Sending " << (is_full ? "full" : "delta") << " catalog of " << changes.size() << " columns, " << totalPayloadSize << " Bytes." << std::endl;)
+
+    char* data = reinterpret_cast<char*>(malloc(totalPayloadSize));
+    char* tmp = data;
+
+    memcpy(tmp, &catalog_version, sizeof(uint64_t));
+    tmp += sizeof(uint64_t);
+
+    memcpy(tmp, &is_full, sizeof(bool));
+    tmp += sizeof(bool);
+
+    memcpy(tmp, &is_push, sizeof(bool));
+    tmp += sizeof(bool);
+
+    // How many columns does the receiver need to read
+    const size_t changeCount = changes.size();
+    memcpy(tmp, &changeCount, sizeof(size_t));
+    tmp += sizeof(size_t);
+
+    for (auto& change : changes) {
+        memcpy(tmp, &change.kind, sizeof(catalog_change_kind_t));
+        tmp += sizeof(catalog_change_kind_t);
+
+        // Meta data of column, element count and data type
+        memcpy(tmp, &change.info, sizeof(col_network_info));
+        tmp += sizeof(col_network_info);
+
+        memcpy(tmp, &change.column_id, sizeof(col_handle_t));
+        tmp += sizeof(col_handle_t);
+
+        // Length of column name
+        const size_t identlen = change.ident.size();
+        memcpy(tmp, &identlen, sizeof(size_t));
+        tmp += sizeof(size_t);
+
+        // Actual column name
+        memcpy(tmp, change.ident.c_str(), identlen);
+        tmp += identlen;
+    }
+
+    const size_t tableCount = announced_tables.size();
+    memcpy(tmp, &tableCount, sizeof(size_t));
+    tmp += sizeof(size_t);
+
+    for (auto& [table, column_ids] : announced_tables) {
+        const size_t identlen = table->ident.size();
+        memcpy(tmp, &identlen, sizeof(size_t));
+        tmp += sizeof(size_t);
+
+        memcpy(tmp, table->ident.c_str(), identlen);
+        tmp += identlen;
+
+        memcpy(tmp, &table->numRows, sizeof(size_t));
+        tmp += sizeof(size_t);
+
+        // The key column is always the first column of a table, see table_t::getPrimaryKeyColumn
+        const size_t keyColumn = 0;
+        memcpy(tmp, &keyColumn, sizeof(size_t));
+        tmp += sizeof(size_t);
+
+        memcpy(tmp, &table->isFactTable, sizeof(bool));
+        tmp += sizeof(bool);
+
+        const size_t columnCount = column_ids.size();
+        memcpy(tmp, &columnCount, sizeof(size_t));
+        tmp += sizeof(size_t);
+
+        memcpy(tmp, column_ids.data(), columnCount * sizeof(col_handle_t));
+        tmp += columnCount * sizeof(col_handle_t);
+    }
+
+    sendMessage(conId, data, totalPayloadSize, nullptr, 0, static_cast<uint8_t>(catalog_communication_code::receive_column_info));
+    free(data);
 }
 
 col_t* DataCatalog::add_remote_column(std::string name, col_network_info ni) {
     std::lock_guard<std::mutex> _lka(appendLock);
 
-    auto it = remote_cols.find(name);
-    if (it != remote_cols.end()) {
+    col_t* present = remote_cols.find(name);
+    if (present != nullptr) {
         LOG_INFO("[DataCatalog] Column with same ident ('" << name << "') already present, cannot add remote column." << std::endl;)
-        return it->second;
+        return present;
     } else {
         LOG_DEBUG1("[DataCatalog] Creating new remote column: " << name << std::endl;)
         col_t* col = new col_t();
@@ -1330,33 +2988,49 @@ col_t* DataCatalog::add_remote_column(std::string name, col_network_info ni) {
         col->is_remote = true;
         col->datatype = (col_data_t)ni.type_info;
         col->allocate_on_numa((col_data_t)ni.type_info, ni.size_info, 0);
-        remote_cols.insert({name, col});
+        remote_cols.insert(name, col);
         return col;
     }
 }
 
 std::vector<std::string> DataCatalog::getLocalColumnNames() const {
     std::vector<std::string> out;
-    for (auto it : cols) {
-        out.push_back(it.first);
+    cols.for_each([&out](const std::string& ident, col_t*) { out.push_back(ident); });
+
+    return out;
+}
+
+std::vector<std::string> DataCatalog::getRemoteTableNames() const {
+    std::lock_guard<std::mutex> lk(remote_info_lock);
+    std::vector<std::string> out;
+    for (auto& table : remote_tables) {
+        out.push_back(table.first);
     }
 
     return out;
 }
 
+bool DataCatalog::find_remote_table(const std::string& ident, remote_table_t& table) const {
+    std::lock_guard<std::mutex> lk(remote_info_lock);
+    auto it = remote_tables.find(ident);
+    if (it == remote_tables.end()) {
+        return false;
+    }
+    table = it->second;
+    return true;
+}
+
 std::vector<std::string> DataCatalog::getRemoteColumnNames() const {
     std::vector<std::string> out;
-    for (auto it : remote_cols) {
-        out.push_back(it.first);
-    }
+    remote_cols.for_each([&out](const std::string& ident, col_t*) { out.push_back(ident); });
 
     return out;
 }
 
 void DataCatalog::print_column(std::string& ident) const {
-    auto it = cols.find(ident);
-    if (it != cols.end()) {
-        LOG_INFO("[DataCatalog]" << (*it).second->print_data_head() << std::endl;)
+    col_t* col = cols.find(ident);
+    if (col != nullptr) {
+        LOG_INFO("[DataCatalog]" << col->print_data_head() << std::endl;)
     } else {
         LOG_WARNING("[DataCatalog] No Entry for ident " << ident << std::endl;)
     }
@@ -1367,9 +3041,9 @@ void DataCatalog::print_all() const {
     if (cols.size() == 0) {
         LOG_INFO("<empty>" << std::endl;)
     }
-    for (auto it : cols) {
-        LOG_INFO("[" << it.first << "]: " << it.second->print_identity() << std::endl;)
-    }
+    cols.for_each([](const std::string& ident, col_t* col) {
+        LOG_INFO("[" << ident << "]: " << col->print_identity() << std::endl;)
+    });
 }
 
 void DataCatalog::print_all_remotes() const {
@@ -1379,9 +3053,9 @@ void DataCatalog::print_all_remotes() const {
     }
     for (auto it : remote_col_info) {
         LOG_INFO("[" << it.first << "]: ";)
-        auto remote_col = remote_cols.find(it.first);
-        if (remote_col != remote_cols.end()) {
-            LOG_INFO(remote_col->second->print_identity();)
+        col_t* remote_col = remote_cols.find(it.first);
+        if (remote_col != nullptr) {
+            LOG_INFO(remote_col->print_identity();)
             auto rem_info = remote_col_info.find(it.first);
             LOG_INFO(" (" << rem_info->second.received_bytes << " received)";)
         } else {
@@ -1396,26 +3070,132 @@ void DataCatalog::eraseAllRemoteColumns() {
     std::lock_guard<std::mutex> _lkb(remote_info_lock);
     std::lock_guard<std::mutex> _lkc(inflightLock);
 
-    for (auto col : remote_cols) {
-        delete col.second;
-        remote_col_info.erase(col.first);
+    for (auto col : remote_cols.clear()) {
+        delete col;
+    }
+    freeRetiredColumns();
+
+    // The column infos stay valid for the known catalog version, only the transfer progress is reset
+    for (auto& info : remote_col_info) {
+        info.second.received_bytes = 0;
     }
 
-    remote_cols.clear();
-    remote_col_info.clear();
+    // Requests still waiting for their window belong to the erased columns
+    std::lock_guard<std::mutex> _lkd(connectionStatsLock);
+    for (auto& [conId, queue] : request_queues) {
+        auto& stats = connection_stats[conId];
+        while (!queue.empty()) {
+            const size_t dropped = queue.pop().chunk_size;
+            stats.requested_bytes = (stats.requested_bytes > dropped) ? stats.requested_bytes - dropped : 0;
+        }
+    }
 }
 
-void DataCatalog::fetchColStub(std::size_t conId, std::string& ident, bool wholeColumn) const {
-    char* payload = reinterpret_cast<char*>(malloc(ident.size() + sizeof(size_t)));
-    const size_t sz = ident.size();
-    memcpy(payload, &sz, sizeof(size_t));
-    memcpy(payload + sizeof(size_t), ident.c_str(), sz);
+// A chunk_size of 0 lets the provider fall back to its own dataCatalog_chunkMaxSize, NEXT_CHUNK_OFFSET to its own per column cursor
+void DataCatalog::fetchColStub(std::size_t conId, std::string& ident, bool wholeColumn, size_t chunk_size, size_t chunk_offset, request_priority_t priority) const {
+    column_request_t request{chunk_size, chunk_offset, columnIdOf(conId, ident), priority, wholeColumn};
+    if (request.column_id == INVALID_COL_HANDLE) {
+        LOG_WARNING("[DataCatalog] Column " << ident << " was not announced by the provider of connection " << conId << ", fetch column info first -- discarding request." << std::endl;)
+        return;
+    }
     catalog_communication_code code = wholeColumn ? catalog_communication_code::fetch_column_data : catalog_communication_code::fetch_column_chunk;
-    ConnectionManager::getInstance().sendData(conId, payload, sz + sizeof(size_t), nullptr, 0, static_cast<uint8_t>(code));
+    sendMessage(conId, reinterpret_cast<char*>(&request), sizeof(column_request_t), nullptr, 0, static_cast<uint8_t>(code));
+}
+
+/* Requests data of several columns with one message per connection, columns that are complete or still waiting for a chunk are skipped.
+ * Every request is routed to a connection of the least loaded replica of its column, entries sharing a connection are batched.
+ * Whole columns held by several providers are split into one range per replica.
+ * With a request window the entries go through the priority queues of their connections one by one instead.
+ * Payload layout
+ * [ entryCount | column_request_t* ]
+ */
+void DataCatalog::fetchColBatchStub(const std::vector<col_t*>& columns, bool wholeColumn) {
+    struct batch_entry_t {
+        col_t* col;
+        size_t chunk_offset;
+        size_t chunk_size;
+        bool whole_request;
+    };
+
+    std::map<std::size_t, std::vector<batch_entry_t>> requested;
+    for (auto col : columns) {
+        const size_t replicas = getProviders(col->ident).size();
+        const bool whole_request = wholeColumn && replicas <= 1;
+        size_t chunk_offset;
+        size_t chunk_size;
+        while (col->prepare_request(wholeColumn, replicas, chunk_offset, chunk_size)) {
+            const std::size_t conId = scheduleConnection(col->ident, chunk_size);
+            if (dataCatalog_requestWindow > 0) {
+                submitRequest(conId, col->ident, whole_request, chunk_size, chunk_offset, col->priority);
+            } else {
+                requested[conId].push_back({col, chunk_offset, chunk_size, whole_request});
+            }
+        }
+    }
+
+    for (auto& [conId, entries] : requested) {
+        {
+            std::lock_guard<std::mutex> lk(connectionStatsLock);
+            for (auto& entry : entries) {
+                connection_stats[conId].sent_bytes += entry.chunk_size;
+                auto& priority_stats = request_priority_stats[static_cast<size_t>(entry.col->priority)];
+                ++priority_stats.requests;
+                priority_stats.bytes += entry.chunk_size;
+            }
+        }
+
+        const size_t payloadSize = sizeof(size_t) + entries.size() * sizeof(column_request_t);
+        char* payload = reinterpret_cast<char*>(malloc(payloadSize));
+        char* tmp = payload;
+
+        size_t entryCnt = 0;
+        tmp += sizeof(size_t);
+
+        for (auto& entry : entries) {
+            const column_request_t request{entry.chunk_size, entry.chunk_offset, columnIdOf(conId, entry.col->ident), entry.col->priority, entry.whole_request};
+            if (request.column_id == INVALID_COL_HANDLE) {
+                LOG_WARNING("[DataCatalog] Column " << entry.col->ident << " was not announced by the provider of connection " << conId << ", fetch column info first -- discarding request." << std::endl;)
+                continue;
+            }
+            memcpy(tmp, &request, sizeof(column_request_t));
+            tmp += sizeof(column_request_t);
+            ++entryCnt;
+        }
+        memcpy(payload, &entryCnt, sizeof(size_t));
+
+        sendMessage(conId, payload, static_cast<size_t>(tmp - payload), nullptr, 0, static_cast<uint8_t>(catalog_communication_code::fetch_column_batch));
+        free(payload);
+    }
+}
+
+/* Tells every provider holding the column where its data lives, so it can be written without a receive buffer
+ * Payload layout
+ * [ columnNameLength, columnName, address, size, owner ]
+ */
+void DataCatalog::announceDirectRegion(col_t* col) const {
+    const direct_region_t region{reinterpret_cast<uint64_t>(col->data), col->sizeInBytes, direct_region_t::process_token()};
+    const size_t sz = col->ident.size();
+    const size_t payloadSize = sizeof(size_t) + sz + sizeof(uint64_t) + sizeof(size_t) + sizeof(uint64_t);
+    char* payload = reinterpret_cast<char*>(malloc(payloadSize));
+    char* tmp = payload;
+
+    memcpy(tmp, &sz, sizeof(size_t));
+    tmp += sizeof(size_t);
+    memcpy(tmp, col->ident.c_str(), sz);
+    tmp += sz;
+    memcpy(tmp, &region.address, sizeof(uint64_t));
+    tmp += sizeof(uint64_t);
+    memcpy(tmp, &region.size, sizeof(size_t));
+    tmp += sizeof(size_t);
+    memcpy(tmp, &region.owner, sizeof(uint64_t));
+
+    for (auto provider : getProviders(col->ident)) {
+        sendMessage(provider, payload, payloadSize, nullptr, 0, static_cast<uint8_t>(catalog_communication_code::announce_direct_region));
+    }
     free(payload);
 }
 
-// Fetches a chunk of data sized CHUNK_MAX_SIZE containing information for all columns, equal amount of values
+// Fetches a chunk of data sized CHUNK_MAX_SIZE containing information for all columns, equal amount of rows (columns may differ in width)
 void DataCatalog::fetchPseudoPax(std::size_t conId, std::vector<std::string> idents) const {
     size_t string_sizes = 0;
 
@@ -1474,27 +3254,126 @@ void DataCatalog::fetchPseudoPax(std::size_t conId, std::vector<std::string> ide
         tmp += id.size();
     }
     const size_t total_payload_size = (sizeof(size_t) * (idents.size() + 1)) + string_sizes;
-    ConnectionManager::getInstance().sendData(conId, payload, total_payload_size, nullptr, 0, static_cast<uint8_t>(catalog_communication_code::fetch_pseudo_pax));
+    sendMessage(conId, payload, total_payload_size, nullptr, 0, static_cast<uint8_t>(catalog_communication_code::fetch_pseudo_pax));
+    free(payload);
+}
+
+/* Streams the columns of a remote table (all of them, or the given subset) row-aligned with a single request.
+ * Columns that are complete or already requested otherwise are left out, the returned columns are in schema order.
+ * The provider sends all rows without further requests, the stream is not limited by dataCatalog_receiveBudget.
+ * Payload layout
+ * [ identLength, ident, priority, columnCount, [columnId]* ]
+ */
+std::vector<col_t*> DataCatalog::fetchTable(const std::string& ident, const std::vector<std::string>& columns, request_priority_t priority) {
+    remote_table_t table;
+    std::vector<std::pair<std::string, col_network_info>> selected;
+    {
+        std::lock_guard<std::mutex> lk(remote_info_lock);
+        auto table_it = remote_tables.find(ident);
+        if (table_it == remote_tables.end()) {
+            LOG_WARNING("[DataCatalog] No provider announced table " << ident << ", fetch column info first -- discarding request." << std::endl;)
+            return {};
+        }
+        table = table_it->second;
+        for (auto& column : table.columns) {
+            if (!columns.empty() && std::find(columns.begin(), columns.end(), column) == columns.end()) {
+                continue;
+            }
+            auto info_it = remote_col_info.find(column);
+            if (info_it != remote_col_info.end()) {
+                selected.emplace_back(column, info_it->second);
+            }
+        }
+    }
+    if (!columns.empty() && selected.size() != columns.size()) {
+        LOG_WARNING("[DataCatalog] Not all requested columns belong to table " << ident << " -- fetching the known ones only." << std::endl;)
+    }
+
+    std::vector<col_t*> result;
+    std::vector<col_handle_t> column_ids;
+    for (auto& [column, info] : selected) {
+        col_t* col = find_remote(column);
+        if (col == nullptr) {
+            col = add_remote_column(column, info);
+        }
+        result.push_back(col);
+
+        const col_handle_t column_id = columnIdOf(table.provider, column);
+        std::lock_guard<std::mutex> lk(col->iteratorLock);
+        if (column_id != INVALID_COL_HANDLE && !col->is_complete && col->requested_bytes == 0) {
+            // The whole column arrives with the stream, further chunk requests are not needed
+            col->requested_bytes = col->sizeInBytes;
+            column_ids.push_back(column_id);
+        }
+    }
+    if (column_ids.empty()) {
+        return result;
+    }
+
+    const size_t identlen = ident.size();
+    const size_t columnCount = column_ids.size();
+    const size_t payloadSize = sizeof(size_t) + identlen + sizeof(request_priority_t) + sizeof(size_t) + columnCount * sizeof(col_handle_t);
+    char* payload = reinterpret_cast<char*>(malloc(payloadSize));
+    char* tmp = payload;
+
+    memcpy(tmp, &identlen, sizeof(size_t));
+    tmp += sizeof(size_t);
+    memcpy(tmp, ident.c_str(), identlen);
+    tmp += identlen;
+    memcpy(tmp, &priority, sizeof(request_priority_t));
+    tmp += sizeof(request_priority_t);
+    memcpy(tmp, &columnCount, sizeof(size_t));
+    tmp += sizeof(size_t);
+    memcpy(tmp, column_ids.data(), columnCount * sizeof(col_handle_t));
+
+    sendMessage(table.provider, payload, payloadSize, nullptr, 0, static_cast<uint8_t>(catalog_communication_code::fetch_table));
     free(payload);
+    return result;
 }
 
 void DataCatalog::remoteInfoReady() {
     std::lock_guard<std::mutex> lk(remote_info_lock);
-    col_info_received = true;
+    if (pending_info_replies > 0) {
+        --pending_info_replies;
+    }
     remote_info_available.notify_all();
 }
 
-void DataCatalog::fetchRemoteInfo() {
+/* Providers that push their updates to us and whose catalog version is known are skipped,
+ * all others are asked in parallel for the changes since the last known version.
+ * Afterwards missing column objects (e.g. after eraseAllRemoteColumns) are recreated from the merged column infos.
+ * Payload layout
+ * [ knownVersion, subscribe ]
+ */
+void DataCatalog::fetchRemoteInfo(bool force) {
     std::unique_lock<std::mutex> lk(remote_info_lock);
-    col_info_received = false;
-    ConnectionManager::getInstance().sendOpCode(1, static_cast<uint8_t>(catalog_communication_code::send_column_info), true);
-    // while (!col_info_received) {
-    //     using namespace std::chrono_literals;
-    //     if (!remote_info_available.wait_for(lk, 1s, [this] { return col_info_received; })) {
-    //         ConnectionManager::getInstance().sendOpCode(1, static_cast<uint8_t>(catalog_communication_code::send_column_info));
-    //     }
-    // }
-    remote_info_available.wait(lk, [this] { return col_info_received; });
+    std::unique_lock<std::mutex> lkp(placementLock);
+    pending_info_replies = 0;
+    for (auto& [provider, info] : providers) {
+        if (!force && info.catalog_subscribed && info.catalog_version > 0) {
+            continue;
+        }
+
+        const bool subscribe = dataCatalog_catalogPush;
+        info.catalog_subscribed |= subscribe;
+
+        const size_t payloadSize = sizeof(uint64_t) + sizeof(bool);
+        char* payload = reinterpret_cast<char*>(malloc(payloadSize));
+        memcpy(payload, &info.catalog_version, sizeof(uint64_t));
+        memcpy(payload + sizeof(uint64_t), &subscribe, sizeof(bool));
+        sendMessage(provider, payload, payloadSize, nullptr, 0, static_cast<uint8_t>(catalog_communication_code::send_column_info));
+        free(payload);
+        ++pending_info_replies;
+    }
+    lkp.unlock();
+
+    remote_info_available.wait(lk, [this] { return pending_info_replies == 0; });
+
+    for (auto& info : remote_col_info) {
+        if (!find_remote(info.first)) {
+            add_remote_column(info.first, info.second);
+        }
+    }
 }
 
 void DataCatalog::reconfigureChunkSize(const uint64_t newChunkSize, const uint64_t newChunkThreshold) {
@@ -1508,23 +3387,44 @@ void DataCatalog::reconfigureChunkSize(const uint64_t newChunkSize, const uint64
     dataCatalog_chunkMaxSize = newChunkSize;
     dataCatalog_chunkThreshold = newChunkThreshold;
 
-    char* ptr = reinterpret_cast<char*>(&dataCatalog_chunkMaxSize);
+    // Payload layout [ chunkSize, chunkThreshold ], see cb_reconfigureChunkSize
+    uint64_t payload[2] = {newChunkSize, newChunkThreshold};
 
     std::unique_lock<std::mutex> lk(reconfigure_lock);
-    reconfigured = false;
-    ConnectionManager::getInstance().sendData(1, ptr, sizeof(uint64_t), nullptr, 0, static_cast<uint8_t>(catalog_communication_code::reconfigure_chunk_size));
-    reconfigure_done.wait(lk, [this] { return reconfigured; });
+    for (auto conId : controlConnections()) {
+        ++pending_reconfigure_acks;
+        sendMessage(conId, reinterpret_cast<char*>(payload), sizeof(payload), nullptr, 0, static_cast<uint8_t>(catalog_communication_code::reconfigure_chunk_size));
+    }
+    reconfigure_done.wait(lk, [this] { return pending_reconfigure_acks == 0; });
+}
+
+void DataCatalog::generateSSBData(const double scaleFactor, const uint64_t numaNode, bool sendToRemote) {
+    if (!sendToRemote) {
+        SSB::generate(scaleFactor, numaNode);
+        return;
+    }
+
+    // The provider acknowledges like for generateBenchmarkData
+    std::unique_lock<std::mutex> lk(dataGenerationLock);
+    char payload[sizeof(double) + sizeof(uint64_t)];
+    std::memcpy(payload, &scaleFactor, sizeof(double));
+    std::memcpy(payload + sizeof(double), &numaNode, sizeof(uint64_t));
+    for (auto conId : controlConnections()) {
+        ++pending_generation_acks;
+        sendMessage(conId, payload, sizeof(payload), nullptr, 0, static_cast<uint8_t>(catalog_communication_code::generate_ssb_data));
+    }
+    data_generation_done.wait(lk, [this] { return pending_generation_acks == 0; });
 }
 
-void DataCatalog::generateBenchmarkData(const uint64_t distinctLocalColumns, const uint64_t remoteColumnsForLocal, const uint64_t localColumnElements, const uint64_t percentageOfRemote, const uint64_t localNumaNode, const uint64_t remoteNumaNode, bool sendToRemote, bool createTables) {
-    LOG_DEBUG1("Generating Benchmark Data" << std::endl;)
+void DataCatalog::generateBenchmarkData(const uint64_t distinctLocalColumns, const uint64_t remoteColumnsForLocal, const uint64_t localColumnElements, const uint64_t percentageOfRemote, const uint64_t localNumaNode, const uint64_t remoteNumaNode, bool sendToRemote, bool createTables, const gen_spec_t& spec) {
+    LOG_DEBUG1("Generating Benchmark Data (" << DataGenerator::distribution_to_string(spec.distribution) << ")" << std::endl;)
 
     const uint64_t remoteColumnSize = localColumnElements * percentageOfRemote * 0.01;
 
     if (sendToRemote) {
         std::unique_lock<std::mutex> lk(dataGenerationLock);
-        dataGenerationDone = false;
-        char* remInfos = reinterpret_cast<char*>(std::malloc(sizeof(uint64_t) * 6 + sizeof(bool)));
+        const size_t remInfoSize = sizeof(uint64_t) * 6 + sizeof(bool) + sizeof(gen_spec_t);
+        char* remInfos = reinterpret_cast<char*>(std::malloc(remInfoSize));
         char* tmp = remInfos;
         std::memcpy(reinterpret_cast<void*>(tmp), &distinctLocalColumns, sizeof(uint64_t));
         tmp += sizeof(uint64_t);
@@ -1539,45 +3439,51 @@ void DataCatalog::generateBenchmarkData(const uint64_t distinctLocalColumns, con
         std::memcpy(reinterpret_cast<void*>(tmp), &remoteNumaNode, sizeof(uint64_t));
         tmp += sizeof(uint64_t);
         std::memcpy(reinterpret_cast<void*>(tmp), &createTables, sizeof(bool));
+        tmp += sizeof(bool);
+        std::memcpy(reinterpret_cast<void*>(tmp), &spec, sizeof(gen_spec_t));
 
-        ConnectionManager::getInstance().sendData(1, remInfos, sizeof(uint64_t) * 6 + sizeof(bool), nullptr, 0, static_cast<uint8_t>(catalog_communication_code::generate_benchmark_data));
+        for (auto conId : controlConnections()) {
+            ++pending_generation_acks;
+            sendMessage(conId, remInfos, remInfoSize, nullptr, 0, static_cast<uint8_t>(catalog_communication_code::generate_benchmark_data));
+        }
+        std::free(remInfos);
     }
 
     if (createTables) {
         LOG_DEBUG1("Creating Tables" << std::endl;)
-#pragma omp parallel for schedule(static, 2) num_threads(8)
+        // Columns are filled by all threads, so tables are created one after another
         for (size_t i = 0; i < distinctLocalColumns; ++i) {
             std::string name = "tab_" + std::to_string(i);
 
-            DataCatalog::getInstance().tables.insert(std::make_pair(name, new table_t(name, remoteColumnsForLocal + 1, localColumnElements, 0, percentageOfRemote, true)));
+            add_table(new table_t(name, remoteColumnsForLocal + 1, localColumnElements, 0, percentageOfRemote, true, spec));
 
             for (size_t j = 0; j < remoteColumnsForLocal; ++j) {
                 std::string sub_name = name + "_" + std::to_string(j);
-                DataCatalog::getInstance().tables.insert(std::make_pair(sub_name, new table_t(sub_name, 2, remoteColumnSize, 0, percentageOfRemote, false)));
+                add_table(new table_t(sub_name, 2, remoteColumnSize, 0, percentageOfRemote, false, spec));
             }
         }
     } else {
         LOG_DEBUG1("Creating Columns" << std::endl;)
-#pragma omp parallel for schedule(static, 2) num_threads(8)
+        // A correlated spec correlates the sub columns with their local column, which is uniform itself
+        gen_spec_t local_spec = spec;
+        if (local_spec.distribution == gen_distribution_t::correlated) {
+            local_spec.distribution = gen_distribution_t::uniform;
+        }
         for (size_t i = 0; i < distinctLocalColumns; ++i) {
             std::string name = "col_" + std::to_string(i);
 
-            generate(name, col_data_t::gen_bigint, localColumnElements, localNumaNode);
+            generate(name, col_data_t::gen_bigint, localColumnElements, localNumaNode, local_spec);
 
             for (size_t j = 0; j < remoteColumnsForLocal; ++j) {
                 std::string sub_name = name + "_" + std::to_string(j);
-                generate(sub_name, col_data_t::gen_bigint, remoteColumnSize, remoteNumaNode);
+                generate(sub_name, col_data_t::gen_bigint, remoteColumnSize, remoteNumaNode, spec, name);
             }
         }
     }
 
     if (sendToRemote) {
         std::unique_lock<std::mutex> lk(dataGenerationLock);
-        if (!dataGenerationDone) {
-            data_generation_done.wait(lk, [this] { return dataGenerationDone; });
-        }
-    } else {
-        ConnectionManager::getInstance().sendOpCode(1, static_cast<uint8_t>(catalog_communication_code::ack_generate_benchmark_data), true);
+        data_generation_done.wait(lk, [this] { return pending_generation_acks == 0; });
     }
 
     print_all();
@@ -0,0 +1,395 @@
+#include "FileLoader.hpp"
+
+#include <Column.h>
+#include <fcntl.h>
+#include <omp.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace {
+
+// Ranges smaller than this are not worth a thread of their own
+constexpr size_t MIN_RANGE_BYTES = 1 << 20;
+constexpr size_t COPY_BLOCK_BYTES = 1 << 26;
+
+// Read-only mapping of a whole file, data is nullptr if it cannot be mapped or is empty
+struct mapped_file_t {
+    const char* data = nullptr;
+    size_t size = 0;
+
+    explicit mapped_file_t(const std::string& path) {
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (ptr != MAP_FAILED) {
+                // Ranges are parsed in parallel, so read ahead everywhere instead of sequentially
+                madvise(ptr, st.st_size, MADV_WILLNEED);
+                data = static_cast<const char*>(ptr);
+                size = st.st_size;
+            }
+        }
+        close(fd);
+    }
+
+    ~mapped_file_t() {
+        if (data != nullptr) {
+            munmap(const_cast<char*>(data), size);
+        }
+    }
+
+    mapped_file_t(mapped_file_t const&) = delete;
+    void operator=(mapped_file_t const&) = delete;
+};
+
+struct column_target_t {
+    col_data_t type;
+    void* data;
+};
+
+const char* lineEnd(const char* p, const char* end) {
+    const void* newline = std::memchr(p, '\n', end - p);
+    return newline ? static_cast<const char*>(newline) : end;
+}
+
+const char* nextLine(const char* p, const char* end) {
+    const char* line_end = lineEnd(p, end);
+    return (line_end == end) ? end : line_end + 1;
+}
+
+bool isBlank(const char* p, const char* line_end) {
+    return p == line_end || (line_end - p == 1 && *p == '\r');
+}
+
+// SWAR digit checks as in simdjson (Langdale, Lemire), eight characters are tested and converted at once
+bool isEightDigits(const char* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(uint64_t));
+    return (((v & 0xF0F0F0F0F0F0F0F0) | (((v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333);
+}
+
+uint64_t parseEightDigits(const char* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(uint64_t));
+    v -= 0x3030303030303030;
+    v = (v * 10) + (v >> 8);
+    return (((v & 0x000000FF000000FF) * 0x000F424000000064) + (((v >> 16) & 0x000000FF000000FF) * 0x0000271000000001)) >> 32;
+}
+
+// result = result * factor + addend, false if that does not fit into 64 bit
+inline bool mulAddChecked(uint64_t& result, const uint64_t factor, const uint64_t addend) {
+    if (result > (std::numeric_limits<uint64_t>::max() - addend) / factor) {
+        return false;
+    }
+    result = result * factor + addend;
+    return true;
+}
+
+// Returns the end of the digits, p if there are none and nullptr if the value does not fit into 64 bit
+const char* parseUnsigned(const char* p, const char* end, uint64_t& value) {
+    uint64_t result = 0;
+    const char* q = p;
+    while (end - q >= 8 && isEightDigits(q)) {
+        if (!mulAddChecked(result, 100000000, parseEightDigits(q))) {
+            return nullptr;
+        }
+        q += 8;
+    }
+    while (q < end && static_cast<unsigned char>(*q - '0') < 10) {
+        if (!mulAddChecked(result, 10, *q - '0')) {
+            return nullptr;
+        }
+        ++q;
+    }
+    value = result;
+    return q;
+}
+
+// Returns the end of the parsed value, nullptr if the field does not start with a value of type T
+template <typename T>
+const char* parseValue(const char* p, const char* end, T& value) {
+    while (p < end && *p == ' ') {
+        ++p;
+    }
+    if constexpr (std::is_integral<T>::value) {
+        uint64_t v;
+        const char* q = parseUnsigned(p, end, v);
+        if (q == nullptr || q == p || v > std::numeric_limits<T>::max()) {
+            return nullptr;
+        }
+        value = static_cast<T>(v);
+        return q;
+    } else {
+        auto [q, ec] = std::from_chars(p, end, value);
+        return (ec == std::errc()) ? q : nullptr;
+    }
+}
+
+template <typename T>
+const char* parseInto(const char* p, const char* end, void* data, const size_t row) {
+    T value = 0;
+    const char* q = parseValue<T>(p, end, value);
+    static_cast<T*>(data)[row] = q ? value : 0;
+    return q;
+}
+
+const char* parseField(const column_target_t& target, const char* p, const char* end, const size_t row) {
+    switch (target.type) {
+        case col_data_t::gen_smallint:
+            return parseInto<uint8_t>(p, end, target.data, row);
+        case col_data_t::gen_bigint:
+            return parseInto<uint64_t>(p, end, target.data, row);
+        case col_data_t::gen_float:
+            return parseInto<float>(p, end, target.data, row);
+        case col_data_t::gen_double:
+            return parseInto<double>(p, end, target.data, row);
+        default:
+            return nullptr;
+    }
+}
+
+// Parses the line [p, end) into row of all targets, returns false if a field was malformed or missing (and stored as 0)
+bool parseLine(const char* p, const char* end, const std::vector<column_target_t>& targets, const size_t row, const char delimiter) {
+    bool valid = true;
+    for (size_t c = 0; c < targets.size(); ++c) {
+        const bool last = (c + 1 == targets.size());
+        // p is nullptr once the line ran out of fields, the remaining columns get 0
+        const char* q = parseField(targets[c], p ? p : end, end, row);
+        if (q != nullptr) {
+            while (q < end && (*q == ' ' || *q == '\r')) {
+                ++q;
+            }
+        }
+        if (p != nullptr && q != nullptr && (last ? q == end : (q < end && *q == delimiter))) {
+            p = last ? end : q + 1;
+            continue;
+        }
+
+        // The following fields keep their position, the rest of the malformed field is skipped
+        valid = false;
+        if (p != nullptr && !last) {
+            const void* next = std::memchr(p, delimiter, end - p);
+            p = next ? static_cast<const char*>(next) + 1 : nullptr;
+        }
+    }
+    return valid;
+}
+
+std::vector<std::string> splitHeader(const char* p, const char* end, const char delimiter) {
+    std::vector<std::string> names;
+    while (true) {
+        const void* next = std::memchr(p, delimiter, end - p);
+        const char* field_end = next ? static_cast<const char*>(next) : end;
+        std::string name(p, field_end);
+        name.erase(0, name.find_first_not_of(" \r"));
+        name.erase(name.find_last_not_of(" \r") + 1);
+        names.push_back(name);
+        if (!next) {
+            return names;
+        }
+        p = field_end + 1;
+    }
+}
+
+}  // namespace
+
+table_t* FileLoader::loadCsv(const std::string& path, const std::string& table, const csv_options_t& options) {
+    DataCatalog& catalog = DataCatalog::getInstance();
+    if (catalog.has_table(table)) {
+        LOG_ERROR("[FileLoader] Table " << table << " already present, not loading " << path << "." << std::endl;)
+        return nullptr;
+    }
+
+    mapped_file_t file(path);
+    if (file.data == nullptr) {
+        LOG_ERROR("[FileLoader] Could not map " << path << " or it is empty." << std::endl;)
+        return nullptr;
+    }
+    auto s_ts = std::chrono::high_resolution_clock::now();
+    const char* file_end = file.data + file.size;
+
+    const char* data_start = file.data;
+    std::vector<std::string> names;
+    if (options.header) {
+        const char* header_end = lineEnd(file.data, file_end);
+        names = splitHeader(file.data, header_end, options.delimiter);
+        data_start = nextLine(file.data, file_end);
+    }
+
+    std::vector<col_data_t> types = options.types;
+    if (types.empty()) {
+        const char* first = data_start;
+        while (first < file_end && isBlank(first, lineEnd(first, file_end))) {
+            first = nextLine(first, file_end);
+        }
+        const size_t fields = std::count(first, lineEnd(first, file_end), options.delimiter) + 1;
+        types.assign(options.header ? names.size() : fields, col_data_t::gen_bigint);
+    }
+    if (options.header && names.size() != types.size()) {
+        LOG_ERROR("[FileLoader] The header of " << path << " names " << names.size() << " columns, " << types.size() << " types were given." << std::endl;)
+        return nullptr;
+    }
+    if (!options.header) {
+        for (size_t c = 0; c < types.size(); ++c) {
+            names.push_back(table + "_col_" + std::to_string(c));
+        }
+    }
+    for (auto& name : names) {
+        if (catalog.find_local(name) != nullptr) {
+            LOG_ERROR("[FileLoader] Column " << name << " already present, not loading " << path << "." << std::endl;)
+            return nullptr;
+        }
+    }
+
+    // Range boundaries are moved to the next line start, so no line is split between threads
+    const size_t bytes = file_end - data_start;
+    const size_t range_count = std::max<size_t>(1, std::min<size_t>(bytes / MIN_RANGE_BYTES, omp_get_max_threads() * 4));
+    std::vector<const char*> bounds(range_count + 1, file_end);
+    bounds[0] = data_start;
+    for (size_t r = 1; r < range_count; ++r) {
+        const char* candidate = data_start + (bytes / range_count) * r;
+        bounds[r] = std::max(bounds[r - 1], (candidate[-1] == '\n') ? candidate : nextLine(candidate, file_end));
+    }
+
+    std::vector<size_t> row_offsets(range_count + 1, 0);
+#pragma omp parallel for schedule(static)
+    for (size_t r = 0; r < range_count; ++r) {
+        size_t rows = 0;
+        for (const char* p = bounds[r]; p < bounds[r + 1]; p = nextLine(p, bounds[r + 1])) {
+            rows += !isBlank(p, lineEnd(p, bounds[r + 1]));
+        }
+        row_offsets[r + 1] = rows;
+    }
+    for (size_t r = 0; r < range_count; ++r) {
+        row_offsets[r + 1] += row_offsets[r];
+    }
+    const size_t rows = row_offsets[range_count];
+    if (rows == 0) {
+        LOG_ERROR("[FileLoader] " << path << " has no rows." << std::endl;)
+        return nullptr;
+    }
+
+    std::vector<col_t*> columns;
+    std::vector<column_target_t> targets;
+    for (size_t c = 0; c < types.size(); ++c) {
+        col_t* col = new col_t();
+        col->ident = names[c];
+        col->datatype = types[c];
+        col->allocate_on_numa(types[c], rows, options.node);
+        col->readableOffset = col->sizeInBytes;
+        col->is_remote = false;
+        col->is_complete = true;
+        columns.push_back(col);
+        targets.push_back({types[c], col->data});
+    }
+
+    size_t malformed = 0;
+#pragma omp parallel for schedule(static) reduction(+ : malformed)
+    for (size_t r = 0; r < range_count; ++r) {
+        size_t row = row_offsets[r];
+        for (const char* p = bounds[r]; p < bounds[r + 1]; p = nextLine(p, bounds[r + 1])) {
+            const char* line_end = lineEnd(p, bounds[r + 1]);
+            if (isBlank(p, line_end)) {
+                continue;
+            }
+            malformed += !parseLine(p, line_end, targets, row++, options.delimiter);
+        }
+    }
+
+    // A concurrent load may have added a column or the table of the same name meanwhile, the table is only added with all of its columns
+    for (size_t c = 0; c < columns.size(); ++c) {
+        if (catalog.add_column(columns[c]->ident, columns[c]) != columns[c]) {
+            LOG_ERROR("[FileLoader] Column " << columns[c]->ident << " was added concurrently, not loading " << path << "." << std::endl;)
+            for (size_t added = 0; added < c; ++added) {
+                catalog.remove_column(columns[added]->ident);
+            }
+            for (auto col : columns) {
+                delete col;
+            }
+            return nullptr;
+        }
+    }
+
+    table_t* result = new table_t(table, 0);
+    for (auto col : columns) {
+        result->addColumn(col);
+    }
+    if (!catalog.add_table(result)) {
+        LOG_ERROR("[FileLoader] Table " << table << " was added concurrently, not loading " << path << "." << std::endl;)
+        for (auto col : columns) {
+            catalog.remove_column(col->ident);
+        }
+        delete result;  // Deletes the columns as well
+        return nullptr;
+    }
+
+    std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - s_ts;
+    if (malformed > 0) {
+        LOG_WARNING("[FileLoader] " << malformed << " rows of " << path << " had malformed or missing fields, they were loaded as 0." << std::endl;)
+    }
+    LOG_INFO("[FileLoader] Loaded " << rows << " rows with " << columns.size() << " columns from " << path << " in " << secs.count() << " s (" << (file.size / secs.count() / 1024 / 1024) << " MiB/s)" << std::endl;)
+    return result;
+}
+
+col_t* FileLoader::loadBinary(const std::string& path, const std::string& ident, col_data_t type, int node) {
+    DataCatalog& catalog = DataCatalog::getInstance();
+    const size_t width = col_network_info::col_data_type_width(type);
+    if (width == 0) {
+        LOG_ERROR("[FileLoader] Invalid datatype for " << ident << "." << std::endl;)
+        return nullptr;
+    }
+    if (catalog.find_local(ident) != nullptr) {
+        LOG_ERROR("[FileLoader] Column " << ident << " already present, not loading " << path << "." << std::endl;)
+        return nullptr;
+    }
+
+    mapped_file_t file(path);
+    if (file.data == nullptr) {
+        LOG_ERROR("[FileLoader] Could not map " << path << " or it is empty." << std::endl;)
+        return nullptr;
+    }
+    if (file.size % width != 0) {
+        LOG_ERROR("[FileLoader] The size of " << path << " is no multiple of " << width << " bytes." << std::endl;)
+        return nullptr;
+    }
+    auto s_ts = std::chrono::high_resolution_clock::now();
+
+    col_t* col = new col_t();
+    col->ident = ident;
+    col->datatype = type;
+    col->allocate_on_numa(type, file.size / width, node);
+
+    char* target = static_cast<char*>(col->data);
+    const size_t blocks = (file.size + COPY_BLOCK_BYTES - 1) / COPY_BLOCK_BYTES;
+#pragma omp parallel for schedule(static)
+    for (size_t b = 0; b < blocks; ++b) {
+        const size_t offset = b * COPY_BLOCK_BYTES;
+        std::memcpy(target + offset, file.data + offset, std::min(COPY_BLOCK_BYTES, file.size - offset));
+    }
+    col->readableOffset = col->sizeInBytes;
+    col->is_remote = false;
+    col->is_complete = true;
+
+    // A concurrent load of the same ident may have won the race, its column is kept
+    col_t* added = catalog.add_column(ident, col);
+    if (added != col) {
+        delete col;
+        LOG_ERROR("[FileLoader] Column " << ident << " was added concurrently, not loading " << path << "." << std::endl;)
+        return nullptr;
+    }
+
+    std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - s_ts;
+    LOG_INFO("[FileLoader] Loaded " << col->size << " values into " << ident << " from " << path << " in " << secs.count() << " s (" << (file.size / secs.count() / 1024 / 1024) << " MiB/s)" << std::endl;)
+    return col;
+}
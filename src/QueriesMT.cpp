@@ -1,14 +1,20 @@
 #include <Column.h>
 #include <DataCatalog.h>
+#include <PipelineExecutor.hpp>
+#include <PrefetchPlanner.hpp>
 #include <Queries.h>
 #include <omp.h>
 
+#include <atomic>
 #include <future>
 
 inline void wait_col_data_ready(col_t* _col, char* _data) {
     std::unique_lock<std::mutex> lk(_col->iteratorLock);
     if (!(_data < static_cast<char*>(_col->current_end))) {
-        _col->iterator_data_available.wait(lk, [_col, _data] { return reinterpret_cast<uint64_t*>(_data) < static_cast<uint64_t*>(_col->current_end); });
+        _col->iterator_data_available.wait(lk, [_col, _data] { return reinterpret_cast<uint64_t*>(_data) < static_cast<uint64_t*>(_col->current_end) || _col->retired; });
+        if (_col->retired) {
+            LOG_ERROR("[QueriesMT] Column " << _col->ident << " was replaced on the provider while being scanned, results are invalid." << std::endl;)
+        }
     }
 };
 
@@ -238,9 +244,7 @@ uint64_t pipeTempOne(col_t* column1, col_t* column2, col_t* column3, const uint6
         if (paxed) {
             DataCatalog::getInstance().fetchPseudoPax(1, idents);
         } else {
-            column1->request_data(!chunked);
-            column2->request_data(!chunked);
-            column3->request_data(!chunked);
+            DataCatalog::getInstance().fetchColBatchStub({column1, column2, column3}, !chunked);
         }
     }
 
@@ -255,7 +259,7 @@ uint64_t pipeTempOne(col_t* column1, col_t* column2, col_t* column3, const uint6
         }
 
         const size_t appMetaSize = 3 * sizeof(size_t) + (sizeof(size_t) * idents.size()) + total_id_len;
-        const size_t maximumPayloadSize = ConnectionManager::getInstance().getConnectionById(1)->maxBytesInPayload(appMetaSize);
+        const size_t maximumPayloadSize = DataCatalog::getInstance().maxPayloadSize(1, appMetaSize);
 
         max_elems_per_chunk = ((maximumPayloadSize / idents.size()) / (sizeof(uint64_t) * 4)) * 4;
         standard_block_elements = max_elems_per_chunk;
@@ -303,8 +307,7 @@ uint64_t pipeTempOne(col_t* column1, col_t* column2, col_t* column3, const uint6
             wait_col_data_ready(column3, reinterpret_cast<char*>(data_3));
             if (reloading) {
                 if (chunked) {
-                    column2->request_data(!chunked);
-                    column3->request_data(!chunked);
+                    DataCatalog::getInstance().fetchColBatchStub({column2, column3}, !chunked);
                 }
             }
         }
@@ -315,6 +318,14 @@ uint64_t pipeTempOne(col_t* column1, col_t* column2, col_t* column3, const uint6
             sums[tid] += (data_2[idx] * data_3[idx]);
             // ++sum;
         }
+
+        // Hand the receive budget of this block back, see DataCatalog::dataCatalog_receiveBudget
+        if (remote && !paxed) {
+            const size_t blockBytes = currentBlockElems * sizeof(uint64_t);
+            column1->consume(blockBytes);
+            column2->consume(blockBytes);
+            column3->consume(blockBytes);
+        }
     }
 
     uint64_t sum = 0;
@@ -326,6 +337,99 @@ uint64_t pipeTempOne(col_t* column1, col_t* column2, col_t* column3, const uint6
     return sum;
 }
 
+// One block of pipeTempOne: suspends instead of blocking while a column range is not resident yet
+PipelineExecutor::morsel_task_t pipeTempOneMorsel(PipelineExecutor& executor, col_t* column1, col_t* column2, col_t* column3, const uint64_t predicate, const size_t baseOffset, const size_t blockElems, const bool chunked, std::atomic<uint64_t>* result) {
+    const size_t byteOffset = baseOffset * sizeof(uint64_t);
+    const size_t byteSize = blockElems * sizeof(uint64_t);
+
+    // A range that never becomes resident skips the block, its receive budget is given back all the same
+    if (co_await executor.data_ready(column1, byteOffset, byteSize, !chunked)) {
+        auto le_idx = less_than<false, false, false, true>(column1, predicate, baseOffset, blockElems, {}, false);
+
+        if (co_await executor.data_ready(column2, byteOffset, byteSize, !chunked) && co_await executor.data_ready(column3, byteOffset, byteSize, !chunked)) {
+            auto data_2 = reinterpret_cast<uint64_t*>(column2->data) + baseOffset;
+            auto data_3 = reinterpret_cast<uint64_t*>(column3->data) + baseOffset;
+
+            uint64_t sum = 0;
+            for (auto idx : le_idx) {
+                sum += (data_2[idx] * data_3[idx]);
+            }
+            result->fetch_add(sum, std::memory_order_relaxed);
+        }
+    }
+
+    column1->consume(byteSize);
+    column2->consume(byteSize);
+    column3->consume(byteSize);
+}
+
+// Coroutine counterpart of pipeTempOne, the morsels are spawned on an executor shared with other pipelines
+template <bool chunked>
+void pipeTempOneCoro(PipelineExecutor& executor, col_t* column1, col_t* column2, col_t* column3, const uint64_t predicate, std::atomic<uint64_t>* result) {
+    const size_t OPTIMAL_BLOCK_SIZE_MT = 262144;
+    const size_t columnSize = column1->size;
+    const size_t standard_block_elements = (OPTIMAL_BLOCK_SIZE_MT / sizeof(uint64_t)) / 4;
+
+    for (size_t baseOffset = 0; baseOffset < columnSize; baseOffset += standard_block_elements) {
+        const size_t blockElems = (columnSize - baseOffset < standard_block_elements) ? columnSize - baseOffset : standard_block_elements;
+        executor.spawn(pipeTempOneMorsel(executor, column1, column2, column3, predicate, baseOffset, blockElems, chunked, result));
+    }
+}
+
+// Accesses of pipeTempOne in the order its blocks read them, appended to plan
+void planPipeTempOne(std::vector<prefetch_access_t>& plan, col_t* column1, col_t* column2, col_t* column3, const size_t blockElems) {
+    const size_t columnSize = column1->size;
+    for (size_t baseOffset = 0; baseOffset < columnSize; baseOffset += blockElems) {
+        const size_t byteOffset = baseOffset * sizeof(uint64_t);
+        const size_t byteSize = std::min(blockElems, columnSize - baseOffset) * sizeof(uint64_t);
+        plan.push_back({column1, byteOffset, byteSize});
+        plan.push_back({column2, byteOffset, byteSize});
+        plan.push_back({column3, byteOffset, byteSize});
+    }
+}
+
+// pipeTempOne reading through a PrefetchPlanner, firstAccess is the index of the pipeline's first access in the plan
+uint64_t pipeTempOnePlanned(PrefetchPlanner& planner, const size_t firstAccess, col_t* column1, col_t* column2, col_t* column3, const uint64_t predicate, const size_t blockElems) {
+    const size_t columnSize = column1->size;
+    const size_t num_blocks = (columnSize / blockElems) + (columnSize % blockElems == 0 ? 0 : 1);
+    std::array<uint64_t, 4> sums{0, 0, 0, 0};
+
+#pragma omp parallel for schedule(static, 1) num_threads(4)
+    for (size_t i = 0; i < num_blocks; ++i) {
+        const size_t baseOffset = i * blockElems;
+        const size_t currentBlockElems = std::min(blockElems, columnSize - baseOffset);
+        const size_t access = firstAccess + 3 * i;
+
+        // All three accesses are acquired even if one fails, release expects an access to be issued
+        std::vector<size_t> le_idx;
+        const bool first_ready = planner.acquire(access);
+        if (first_ready) {
+            le_idx = less_than<false, false, false, true>(column1, predicate, baseOffset, currentBlockElems, {}, false);
+        }
+        const bool second_ready = planner.acquire(access + 1);
+        const bool third_ready = planner.acquire(access + 2);
+
+        if (first_ready && second_ready && third_ready) {
+            auto data_2 = reinterpret_cast<uint64_t*>(column2->data) + baseOffset;
+            auto data_3 = reinterpret_cast<uint64_t*>(column3->data) + baseOffset;
+            int tid = omp_get_thread_num();
+            for (auto idx : le_idx) {
+                sums[tid] += (data_2[idx] * data_3[idx]);
+            }
+        }
+
+        planner.release(access);
+        planner.release(access + 1);
+        planner.release(access + 2);
+    }
+
+    uint64_t sum = 0;
+    for (auto s : sums) {
+        sum += s;
+    }
+    return sum;
+}
+
 template <bool remote, bool chunked, bool paxed, bool prefetching>
 uint64_t pipeTempTwo(col_t* column1, col_t* column2, col_t* column3, const uint64_t predicate, const std::vector<std::string> idents) {
     size_t OPTIMAL_BLOCK_SIZE_MT = 131072;
@@ -334,9 +438,7 @@ uint64_t pipeTempTwo(col_t* column1, col_t* column2, col_t* column3, const uint6
         if (paxed) {
             DataCatalog::getInstance().fetchPseudoPax(1, idents);
         } else {
-            column1->request_data(!chunked);
-            column2->request_data(!chunked);
-            column3->request_data(!chunked);
+            DataCatalog::getInstance().fetchColBatchStub({column1, column2, column3}, !chunked);
         }
     }
 
@@ -351,7 +453,7 @@ uint64_t pipeTempTwo(col_t* column1, col_t* column2, col_t* column3, const uint6
         }
 
         const size_t appMetaSize = 3 * sizeof(size_t) + (sizeof(size_t) * idents.size()) + total_id_len;
-        const size_t maximumPayloadSize = ConnectionManager::getInstance().getConnectionById(1)->maxBytesInPayload(appMetaSize);
+        const size_t maximumPayloadSize = DataCatalog::getInstance().maxPayloadSize(1, appMetaSize);
 
         max_elems_per_chunk = ((maximumPayloadSize / idents.size()) / (sizeof(uint64_t) * 4)) * 4;
         standard_block_elements = max_elems_per_chunk;
@@ -399,8 +501,7 @@ uint64_t pipeTempTwo(col_t* column1, col_t* column2, col_t* column3, const uint6
             wait_col_data_ready(column3, reinterpret_cast<char*>(data_3));
             if (reloading) {
                 if (chunked) {
-                    column2->request_data(!chunked);
-                    column3->request_data(!chunked);
+                    DataCatalog::getInstance().fetchColBatchStub({column2, column3}, !chunked);
                 }
             }
         }
@@ -411,6 +512,14 @@ uint64_t pipeTempTwo(col_t* column1, col_t* column2, col_t* column3, const uint6
             sums[tid] += (data_2[idx] * data_3[idx]);
             // ++sum;
         }
+
+        // Hand the receive budget of this block back, see DataCatalog::dataCatalog_receiveBudget
+        if (remote && !paxed) {
+            const size_t blockBytes = currentBlockElems * sizeof(uint64_t);
+            column1->consume(blockBytes);
+            column2->consume(blockBytes);
+            column3->consume(blockBytes);
+        }
     }
 
     uint64_t sum = 0;
@@ -430,9 +539,7 @@ uint64_t pipeTempThree(col_t* column1, col_t* column2, col_t* column3, const uin
         if (paxed) {
             DataCatalog::getInstance().fetchPseudoPax(1, idents);
         } else {
-            column1->request_data(!chunked);
-            column2->request_data(!chunked);
-            column3->request_data(!chunked);
+            DataCatalog::getInstance().fetchColBatchStub({column1, column2, column3}, !chunked);
         }
     }
 
@@ -447,7 +554,7 @@ uint64_t pipeTempThree(col_t* column1, col_t* column2, col_t* column3, const uin
         }
 
         const size_t appMetaSize = 3 * sizeof(size_t) + (sizeof(size_t) * idents.size()) + total_id_len;
-        const size_t maximumPayloadSize = ConnectionManager::getInstance().getConnectionById(1)->maxBytesInPayload(appMetaSize);
+        const size_t maximumPayloadSize = DataCatalog::getInstance().maxPayloadSize(1, appMetaSize);
 
         max_elems_per_chunk = ((maximumPayloadSize / idents.size()) / (sizeof(uint64_t) * 4)) * 4;
         standard_block_elements = max_elems_per_chunk;
@@ -493,8 +600,7 @@ uint64_t pipeTempThree(col_t* column1, col_t* column2, col_t* column3, const uin
             wait_col_data_ready(column3, reinterpret_cast<char*>(data_3));
             if (reloading) {
                 if (chunked) {
-                    column2->request_data(!chunked);
-                    column3->request_data(!chunked);
+                    DataCatalog::getInstance().fetchColBatchStub({column2, column3}, !chunked);
                 }
             }
         }
@@ -505,6 +611,14 @@ uint64_t pipeTempThree(col_t* column1, col_t* column2, col_t* column3, const uin
             sum += (data_2[idx] * data_3[idx]);
             // ++sum;
         }
+
+        // Hand the receive budget of this block back, see DataCatalog::dataCatalog_receiveBudget
+        if (remote && !paxed) {
+            const size_t blockBytes = currentBlockElems * sizeof(uint64_t);
+            column1->consume(blockBytes);
+            column2->consume(blockBytes);
+            column3->consume(blockBytes);
+        }
     }
 
     return sum;
@@ -522,7 +636,6 @@ uint64_t orchBenchmark1(const std::vector<std::string> idents, const std::array<
         col_t* col;
         if (remote) {
             col = DataCatalog::getInstance().find_remote(ident);
-            if (prefetching && !paxed) col->request_data(!chunked);
         } else {
             col = DataCatalog::getInstance().find_local(ident);
         }
@@ -530,6 +643,10 @@ uint64_t orchBenchmark1(const std::vector<std::string> idents, const std::array<
         columns.push_back(col);
     }
 
+    if (remote && prefetching && !paxed) {
+        DataCatalog::getInstance().fetchColBatchStub(columns, !chunked);
+    }
+
     if (paxed && prefetching) {
         DataCatalog::getInstance().fetchPseudoPax(1, idents);
     }
@@ -561,7 +678,6 @@ uint64_t orchBenchmark2(const std::vector<std::string> idents, const std::array<
         col_t* col;
         if (remote) {
             col = DataCatalog::getInstance().find_remote(ident);
-            if (prefetching && !paxed) col->request_data(!chunked);
         } else {
             col = DataCatalog::getInstance().find_local(ident);
         }
@@ -569,6 +685,10 @@ uint64_t orchBenchmark2(const std::vector<std::string> idents, const std::array<
         columns.push_back(col);
     }
 
+    if (remote && prefetching && !paxed) {
+        DataCatalog::getInstance().fetchColBatchStub(columns, !chunked);
+    }
+
     if (paxed && prefetching) {
         DataCatalog::getInstance().fetchPseudoPax(1, idents);
     }
@@ -601,7 +721,6 @@ uint64_t orchBenchmark3(const std::vector<std::string> idents, const std::array<
         col_t* col;
         if (remote) {
             col = DataCatalog::getInstance().find_remote(ident);
-            if (prefetching && !paxed) col->request_data(!chunked);
         } else {
             col = DataCatalog::getInstance().find_local(ident);
         }
@@ -609,6 +728,10 @@ uint64_t orchBenchmark3(const std::vector<std::string> idents, const std::array<
         columns.push_back(col);
     }
 
+    if (remote && prefetching && !paxed) {
+        DataCatalog::getInstance().fetchColBatchStub(columns, !chunked);
+    }
+
     if (paxed && prefetching) {
         DataCatalog::getInstance().fetchPseudoPax(1, idents);
     }
@@ -641,7 +764,6 @@ uint64_t orchBenchmark4(const std::vector<std::string> idents, const std::array<
         col_t* col;
         if (remote) {
             col = DataCatalog::getInstance().find_remote(ident);
-            if (prefetching && !paxed) col->request_data(!chunked);
         } else {
             col = DataCatalog::getInstance().find_local(ident);
         }
@@ -649,6 +771,10 @@ uint64_t orchBenchmark4(const std::vector<std::string> idents, const std::array<
         columns.push_back(col);
     }
 
+    if (remote && prefetching && !paxed) {
+        DataCatalog::getInstance().fetchColBatchStub(columns, !chunked);
+    }
+
     if (paxed && prefetching) {
         DataCatalog::getInstance().fetchPseudoPax(1, idents);
     }
@@ -668,6 +794,94 @@ uint64_t orchBenchmark4(const std::vector<std::string> idents, const std::array<
     return sum;
 }
 
+// 4 Pipelines on 4 coroutine workers, all morsels are runnable at once and suspend on missing data
+template <bool chunked>
+uint64_t orchBenchmarkCoro(const std::vector<std::string> idents, const std::array<std::array<uint8_t, 3>, 4> idx) {
+    std::vector<col_t*> columns;
+    const std::array predicates{50, 75, 25, 100};
+    std::atomic<uint64_t> sum{0};
+
+    for (auto ident : idents) {
+        columns.push_back(DataCatalog::getInstance().find_remote(ident));
+    }
+
+    PipelineExecutor executor(4);
+    for (size_t i = 0; i < 4; ++i) {
+        pipeTempOneCoro<chunked>(executor, columns[idx[i][0]], columns[idx[i][1]], columns[idx[i][2]], predicates[i], &sum);
+    }
+    executor.wait_all();
+
+    return sum.load();
+}
+
+// orchBenchmark1 without hand-placed requests: one plan covers all 4 pipelines, the planner prefetches across pipeline boundaries
+template <bool chunked>
+uint64_t orchBenchmarkPlanned(const std::vector<std::string> idents, const std::array<std::array<uint8_t, 3>, 4> idx) {
+    const size_t OPTIMAL_BLOCK_SIZE_MT = 262144;
+    const size_t blockElems = (OPTIMAL_BLOCK_SIZE_MT / sizeof(uint64_t)) / 4;
+    std::vector<col_t*> columns;
+    const std::array predicates{50, 75, 25, 100};
+    uint64_t sum = 0;
+
+    for (auto ident : idents) {
+        columns.push_back(DataCatalog::getInstance().find_remote(ident));
+    }
+
+    std::vector<prefetch_access_t> plan;
+    std::array<size_t, 4> firstAccess;
+    for (size_t i = 0; i < 4; ++i) {
+        firstAccess[i] = plan.size();
+        planPipeTempOne(plan, columns[idx[i][0]], columns[idx[i][1]], columns[idx[i][2]], blockElems);
+    }
+
+    PrefetchPlanner planner(std::move(plan), !chunked);
+    for (size_t i = 0; i < 4; ++i) {
+        sum += pipeTempOnePlanned(planner, firstAccess[i], columns[idx[i][0]], columns[idx[i][1]], columns[idx[i][2]], predicates[i], blockElems);
+    }
+
+    return sum;
+}
+
+template <typename Fn>
+void doCoroBenchmark(Fn&& full, Fn&& chunked, std::ofstream& out, const std::string variant, const std::string overlapIdent) {
+    uint64_t sum = 0;
+    std::chrono::time_point<std::chrono::high_resolution_clock> s_ts;
+    std::chrono::time_point<std::chrono::high_resolution_clock> e_ts;
+    std::chrono::duration<double> secs;
+
+    for (size_t i = 0; i < 5; ++i) {
+        DataCatalog::getInstance().fetchRemoteInfo();
+        s_ts = std::chrono::high_resolution_clock::now();
+        sum = full();
+        e_ts = std::chrono::high_resolution_clock::now();
+
+        secs = e_ts - s_ts;
+
+        out << "Remote\tFull\t" << variant << "\t65536\tC-4\t" << overlapIdent << "\t" << sum << "\t" << secs.count() << std::endl
+            << std::flush;
+        std::cout << "Remote\tFull\t" << variant << "\t65536\tC-4\t" << overlapIdent << "\t" << sum << "\t" << secs.count() << std::endl;
+
+        DataCatalog::getInstance().eraseAllRemoteColumns();
+
+        for (uint64_t chunkSize = 1ull << 19; chunkSize <= 1ull << 28; chunkSize <<= 1) {
+            DataCatalog::getInstance().reconfigureChunkSize(chunkSize, chunkSize);
+
+            DataCatalog::getInstance().fetchRemoteInfo();
+            s_ts = std::chrono::high_resolution_clock::now();
+            sum = chunked();
+            e_ts = std::chrono::high_resolution_clock::now();
+
+            secs = e_ts - s_ts;
+
+            out << "Remote\tChunked\t" << variant << "\t" << +DataCatalog::getInstance().dataCatalog_chunkMaxSize << "\tC-4\t" << overlapIdent << "\t" << sum << "\t" << secs.count() << std::endl
+                << std::flush;
+            std::cout << "Remote\tChunked\t" << variant << "\t" << +DataCatalog::getInstance().dataCatalog_chunkMaxSize << "\tC-4\t" << overlapIdent << "\t" << sum << "\t" << secs.count() << std::endl;
+
+            DataCatalog::getInstance().eraseAllRemoteColumns();
+        }
+    }
+}
+
 template <typename Fn>
 void doBenchmark(Fn&& f1, Fn&& f2, Fn&& f3, Fn&& f4, Fn&& f5, Fn&& f6, std::ofstream& out, const std::string benchIdent, const std::string overlapIdent) {
     uint64_t sum = 0;
@@ -794,6 +1008,14 @@ void benchmark(const std::vector<std::string> idents, const std::array<std::arra
                 std::bind(orchBenchmark4<true, false, true, false>, idents, idx),   // Remote Paxed Pipe
                 std::bind(orchBenchmark4<true, false, true, true>, idents, idx),    // Remote Paxed Prefetch
                 out, "4-1", overlapIdent);
+
+    doCoroBenchmark(std::bind(orchBenchmarkCoro<false>, idents, idx),  // Remote Full Coroutine
+                    std::bind(orchBenchmarkCoro<true>, idents, idx),   // Remote Chunked Coroutine
+                    out, "Coroutine", overlapIdent);
+
+    doCoroBenchmark(std::bind(orchBenchmarkPlanned<false>, idents, idx),  // Remote Full Planned
+                    std::bind(orchBenchmarkPlanned<true>, idents, idx),   // Remote Chunked Planned
+                    out, "Planned", overlapIdent);
 }
 
 void executeRemoteMTBenchmarkingQueries(std::string& logName) {
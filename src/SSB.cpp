@@ -0,0 +1,561 @@
+#include "SSB.hpp"
+
+#include <Column.h>
+#include <DataCatalog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "DataGenerator.hpp"
+#include "PrefetchPlanner.hpp"
+
+namespace {
+
+constexpr std::array<uint64_t, 25> NATION_REGION = {0, 1, 1, 1, 4, 0, 3, 3, 2, 2, 4, 4, 2, 4, 0, 0, 0, 1, 2, 3, 4, 2, 3, 3, 1};
+constexpr uint64_t AMERICA = 1;
+constexpr uint64_t ASIA = 2;
+constexpr uint64_t EUROPE = 3;
+constexpr uint64_t UNITED_STATES = 24;
+constexpr uint64_t UNITED_KI1 = 231;
+constexpr uint64_t UNITED_KI5 = 235;
+// dbgen places the last orders 151 days before the end of the date range
+constexpr size_t ORDER_DATE_GAP = 151;
+
+enum class ssb_measure_t : uint8_t {
+    discounted_price,  // sum(lo_extendedprice * lo_discount)
+    revenue,           // sum(lo_revenue)
+    profit             // sum(lo_revenue - lo_supplycost)
+};
+
+// Filters a dimension table and maps every qualifying row to its grouping value, -1 rejects the row
+struct ssb_dimension_t {
+    std::string table;
+    std::string key;
+    std::string foreign_key;
+    std::vector<std::string> attributes;
+    std::function<int64_t(const std::vector<const uint64_t*>&, size_t)> select;
+};
+
+struct ssb_query_t {
+    std::string name;
+    std::vector<ssb_dimension_t> dimensions;
+    ssb_measure_t measure;
+    // Inclusive lineorder filters of flight 1
+    uint64_t min_discount = 0;
+    uint64_t max_discount = UINT64_MAX;
+    uint64_t min_quantity = 0;
+    uint64_t max_quantity = UINT64_MAX;
+};
+
+// Group value of a dimension row by key - min_key
+struct ssb_lookup_t {
+    uint64_t min_key = 0;
+    std::vector<int64_t> values;
+
+    int64_t at(const uint64_t key) const {
+        return (key >= min_key && key - min_key < values.size()) ? values[key - min_key] : -1;
+    }
+};
+
+ssb_dimension_t date(std::vector<std::string> attributes, std::function<int64_t(const std::vector<const uint64_t*>&, size_t)> select) {
+    return {"date", "d_datekey", "lo_orderdate", std::move(attributes), std::move(select)};
+}
+
+ssb_dimension_t customer(std::vector<std::string> attributes, std::function<int64_t(const std::vector<const uint64_t*>&, size_t)> select) {
+    return {"customer", "c_custkey", "lo_custkey", std::move(attributes), std::move(select)};
+}
+
+ssb_dimension_t supplier(std::vector<std::string> attributes, std::function<int64_t(const std::vector<const uint64_t*>&, size_t)> select) {
+    return {"supplier", "s_suppkey", "lo_suppkey", std::move(attributes), std::move(select)};
+}
+
+ssb_dimension_t part(std::vector<std::string> attributes, std::function<int64_t(const std::vector<const uint64_t*>&, size_t)> select) {
+    return {"part", "p_partkey", "lo_partkey", std::move(attributes), std::move(select)};
+}
+
+const std::vector<ssb_query_t>& queries() {
+    using attrs_t = std::vector<const uint64_t*>;
+    static const std::vector<ssb_query_t> ssb_queries = {
+        {.name = "Q1.1",
+         .dimensions = {date({"d_year"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r] == 1993 ? 0 : -1; })},
+         .measure = ssb_measure_t::discounted_price,
+         .min_discount = 1,
+         .max_discount = 3,
+         .max_quantity = 24},
+        {.name = "Q1.2",
+         .dimensions = {date({"d_yearmonthnum"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r] == 199401 ? 0 : -1; })},
+         .measure = ssb_measure_t::discounted_price,
+         .min_discount = 4,
+         .max_discount = 6,
+         .min_quantity = 26,
+         .max_quantity = 35},
+        {.name = "Q1.3",
+         .dimensions = {date({"d_weeknuminyear", "d_year"}, [](const attrs_t& a, size_t r) -> int64_t { return (a[0][r] == 6 && a[1][r] == 1994) ? 0 : -1; })},
+         .measure = ssb_measure_t::discounted_price,
+         .min_discount = 5,
+         .max_discount = 7,
+         .min_quantity = 36,
+         .max_quantity = 40},
+        {.name = "Q2.1",
+         .dimensions = {date({"d_year"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r]; }),
+                        part({"p_category", "p_brand1"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r] == 12 ? a[1][r] : -1; }),
+                        supplier({"s_region"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r] == AMERICA ? 0 : -1; })},
+         .measure = ssb_measure_t::revenue},
+        {.name = "Q2.2",
+         .dimensions = {date({"d_year"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r]; }),
+                        part({"p_brand1"}, [](const attrs_t& a, size_t r) -> int64_t { return (a[0][r] >= 2221 && a[0][r] <= 2228) ? a[0][r] : -1; }),
+                        supplier({"s_region"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r] == ASIA ? 0 : -1; })},
+         .measure = ssb_measure_t::revenue},
+        {.name = "Q2.3",
+         .dimensions = {date({"d_year"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r]; }),
+                        part({"p_brand1"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r] == 2239 ? a[0][r] : -1; }),
+                        supplier({"s_region"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r] == EUROPE ? 0 : -1; })},
+         .measure = ssb_measure_t::revenue},
+        {.name = "Q3.1",
+         .dimensions = {customer({"c_region", "c_nation"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r] == ASIA ? a[1][r] : -1; }),
+                        supplier({"s_region", "s_nation"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r] == ASIA ? a[1][r] : -1; }),
+                        date({"d_year"}, [](const attrs_t& a, size_t r) -> int64_t { return (a[0][r] >= 1992 && a[0][r] <= 1997) ? a[0][r] : -1; })},
+         .measure = ssb_measure_t::revenue},
+        {.name = "Q3.2",
+         .dimensions = {customer({"c_nation", "c_city"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r] == UNITED_STATES ? a[1][r] : -1; }),
+                        supplier({"s_nation", "s_city"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r] == UNITED_STATES ? a[1][r] : -1; }),
+                        date({"d_year"}, [](const attrs_t& a, size_t r) -> int64_t { return (a[0][r] >= 1992 && a[0][r] <= 1997) ? a[0][r] : -1; })},
+         .measure = ssb_measure_t::revenue},
+        {.name = "Q3.3",
+         .dimensions = {customer({"c_city"}, [](const attrs_t& a, size_t r) -> int64_t { return (a[0][r] == UNITED_KI1 || a[0][r] == UNITED_KI5) ? a[0][r] : -1; }),
+                        supplier({"s_city"}, [](const attrs_t& a, size_t r) -> int64_t { return (a[0][r] == UNITED_KI1 || a[0][r] == UNITED_KI5) ? a[0][r] : -1; }),
+                        date({"d_year"}, [](const attrs_t& a, size_t r) -> int64_t { return (a[0][r] >= 1992 && a[0][r] <= 1997) ? a[0][r] : -1; })},
+         .measure = ssb_measure_t::revenue},
+        {.name = "Q3.4",
+         .dimensions = {customer({"c_city"}, [](const attrs_t& a, size_t r) -> int64_t { return (a[0][r] == UNITED_KI1 || a[0][r] == UNITED_KI5) ? a[0][r] : -1; }),
+                        supplier({"s_city"}, [](const attrs_t& a, size_t r) -> int64_t { return (a[0][r] == UNITED_KI1 || a[0][r] == UNITED_KI5) ? a[0][r] : -1; }),
+                        date({"d_yearmonthnum", "d_year"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r] == 199712 ? a[1][r] : -1; })},
+         .measure = ssb_measure_t::revenue},
+        {.name = "Q4.1",
+         .dimensions = {date({"d_year"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r]; }),
+                        customer({"c_region", "c_nation"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r] == AMERICA ? a[1][r] : -1; }),
+                        supplier({"s_region"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r] == AMERICA ? 0 : -1; }),
+                        part({"p_mfgr"}, [](const attrs_t& a, size_t r) -> int64_t { return (a[0][r] == 1 || a[0][r] == 2) ? 0 : -1; })},
+         .measure = ssb_measure_t::profit},
+        {.name = "Q4.2",
+         .dimensions = {date({"d_year"}, [](const attrs_t& a, size_t r) -> int64_t { return (a[0][r] == 1997 || a[0][r] == 1998) ? a[0][r] : -1; }),
+                        customer({"c_region"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r] == AMERICA ? 0 : -1; }),
+                        supplier({"s_region", "s_nation"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r] == AMERICA ? a[1][r] : -1; }),
+                        part({"p_mfgr", "p_category"}, [](const attrs_t& a, size_t r) -> int64_t { return (a[0][r] == 1 || a[0][r] == 2) ? a[1][r] : -1; })},
+         .measure = ssb_measure_t::profit},
+        {.name = "Q4.3",
+         .dimensions = {date({"d_year"}, [](const attrs_t& a, size_t r) -> int64_t { return (a[0][r] == 1997 || a[0][r] == 1998) ? a[0][r] : -1; }),
+                        customer({"c_region"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r] == AMERICA ? 0 : -1; }),
+                        supplier({"s_nation", "s_city"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r] == UNITED_STATES ? a[1][r] : -1; }),
+                        part({"p_category", "p_brand1"}, [](const attrs_t& a, size_t r) -> int64_t { return a[0][r] == 14 ? a[1][r] : -1; })},
+         .measure = ssb_measure_t::profit}};
+    return ssb_queries;
+}
+
+uint64_t* values(col_t* col) {
+    return reinterpret_cast<uint64_t*>(col->data);
+}
+
+col_t* newColumn(const std::string& ident, const size_t rows, const int node) {
+    col_t* col = new col_t();
+    col->ident = ident;
+    col->datatype = col_data_t::gen_bigint;
+    col->allocate_on_numa<uint64_t>(rows, node);
+    col->readableOffset = rows * sizeof(uint64_t);
+    col->current_end = col->data;
+    col->is_remote = false;
+    col->is_complete = true;
+    return col;
+}
+
+// Uniform values in [lower, upper], the stream is derived from the ident as in DataCatalog::generate
+void fillUniform(col_t* col, const uint64_t lower, const uint64_t upper) {
+    gen_spec_t spec;
+    spec.lower = lower;
+    spec.upper = upper;
+    DataGenerator::fill(values(col), col->size, spec, static_cast<uint32_t>(std::hash<std::string>{}(col->ident)));
+}
+
+void fillKeys(col_t* col) {
+    uint64_t* data = values(col);
+#pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < col->size; ++i) {
+        data[i] = i + 1;
+    }
+}
+
+// A concurrent generation may have added the table meanwhile, the columns added here are taken out again then
+void addTable(const std::string& ident, const bool isFactTable, const std::vector<col_t*>& columns) {
+    DataCatalog& catalog = DataCatalog::getInstance();
+    table_t* table = new table_t(ident, 0);
+    table->isFactTable = isFactTable;
+    std::vector<col_t*> added;
+    for (auto col : columns) {
+        table->addColumn(col);
+        if (catalog.add_column(col->ident, col) == col) {
+            added.push_back(col);
+        }
+    }
+    if (!catalog.add_table(table)) {
+        LOG_ERROR("[SSB] Table " << ident << " was added concurrently, discarding the generated one." << std::endl;)
+        for (auto col : added) {
+            catalog.remove_column(col->ident);
+        }
+        delete table;  // Deletes the columns as well
+    }
+}
+
+// customer and supplier share their geography columns
+void addLocationTable(const std::string& ident, const std::string& prefix, const std::string& key, const size_t rows, const int node) {
+    col_t* keys = newColumn(key, rows, node);
+    col_t* city = newColumn(prefix + "_city", rows, node);
+    col_t* nation = newColumn(prefix + "_nation", rows, node);
+    col_t* region = newColumn(prefix + "_region", rows, node);
+
+    fillKeys(keys);
+    fillUniform(nation, 0, NATION_REGION.size() - 1);
+    fillUniform(city, 0, 9);
+    uint64_t* city_data = values(city);
+    const uint64_t* nation_data = values(nation);
+    uint64_t* region_data = values(region);
+#pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < rows; ++i) {
+        city_data[i] += nation_data[i] * 10;
+        region_data[i] = NATION_REGION[nation_data[i]];
+    }
+
+    addTable(ident, false, {keys, city, nation, region});
+}
+
+// p_retailprice of TPC-H in cents
+uint64_t retailPrice(const uint64_t partkey) {
+    return 90000 + ((partkey / 10) % 20001) + 100 * (partkey % 1000);
+}
+
+int64_t measureOf(const ssb_measure_t measure, const std::vector<const uint64_t*>& data, const size_t first, const size_t second, const size_t row) {
+    switch (measure) {
+        case ssb_measure_t::discounted_price:
+            return data[first][row] * data[second][row];
+        case ssb_measure_t::revenue:
+            return data[first][row];
+        case ssb_measure_t::profit:
+            return static_cast<int64_t>(data[first][row]) - static_cast<int64_t>(data[second][row]);
+        default:
+            return 0;
+    }
+}
+
+/* Dimension columns are read completely before the scan starts, remote ones arrive with a single table request.
+ * Returns false if a column is missing or never became resident.
+ */
+bool dimensionColumns(const ssb_mode_t mode, const std::string& table, const std::vector<std::string>& names, std::vector<col_t*>& columns) {
+    DataCatalog& catalog = DataCatalog::getInstance();
+    const bool remote = (mode == ssb_mode_t::remote);
+    if (remote) {
+        catalog.fetchTable(table, names, request_priority_t::interactive);
+    }
+    for (auto& name : names) {
+        col_t* col = remote ? catalog.find_remote(name) : catalog.find_local(name);
+        if (col == nullptr) {
+            LOG_ERROR("[SSB] Column " << name << " of table " << table << " not found, generate the SSB tables first." << std::endl;)
+            return false;
+        }
+        if (remote && !col->request_range(0, col->sizeInBytes).wait()) {
+            LOG_ERROR("[SSB] Column " << name << " of table " << table << " did not arrive." << std::endl;)
+            return false;
+        }
+        columns.push_back(col);
+    }
+    return true;
+}
+
+}  // namespace
+
+std::string SSB::mode_to_string(ssb_mode_t mode) {
+    switch (mode) {
+        case ssb_mode_t::local:
+            return "local";
+        case ssb_mode_t::numa:
+            return "numa";
+        case ssb_mode_t::remote:
+            return "remote";
+        default:
+            return "Mode case not implemented!";
+    }
+}
+
+std::string SSB::query_name(size_t query) {
+    return (query < queries().size()) ? queries()[query].name : "unknown";
+}
+
+std::string SSB::result_to_string(const ssb_result_t& result) {
+    std::stringstream ss;
+    ss << result.groups.size() << " groups from " << result.rows << " rows";
+    size_t printed = 0;
+    for (auto& [key, value] : result.groups) {
+        if (printed++ == 10) {
+            ss << std::endl
+               << "\t...";
+            break;
+        }
+        ss << std::endl
+           << "\t" << key[0] << "\t" << key[1] << "\t" << key[2] << "\t" << key[3] << "\t" << value;
+    }
+    return ss.str();
+}
+
+void SSB::generate(double scaleFactor, int node) {
+    DataCatalog& catalog = DataCatalog::getInstance();
+    if (catalog.has_table("lineorder")) {
+        LOG_INFO("[SSB] Tables already present, keeping them." << std::endl;)
+        return;
+    }
+
+    const size_t customers = std::max<size_t>(30000 * scaleFactor, 1);
+    const size_t suppliers = std::max<size_t>(2000 * scaleFactor, 1);
+    const size_t parts = (scaleFactor >= 1) ? 200000 * static_cast<size_t>(1 + std::log2(scaleFactor)) : std::max<size_t>(200000 * scaleFactor, 1);
+    const size_t lineorders = std::max<size_t>(6000000 * scaleFactor, 1);
+    LOG_INFO("[SSB] Generating scale factor " << scaleFactor << " (" << lineorders << " lineorders) on node " << node << std::endl;)
+    auto s_ts = std::chrono::high_resolution_clock::now();
+
+    using namespace std::chrono;
+    const sys_days first_day = year{1992} / January / 1;
+    const size_t dates = (sys_days{year{1999} / January / 1} - first_day).count();
+    col_t* d_datekey = newColumn("d_datekey", dates, node);
+    col_t* d_year = newColumn("d_year", dates, node);
+    col_t* d_yearmonthnum = newColumn("d_yearmonthnum", dates, node);
+    col_t* d_weeknuminyear = newColumn("d_weeknuminyear", dates, node);
+    for (size_t i = 0; i < dates; ++i) {
+        const sys_days day = first_day + std::chrono::days(i);
+        const year_month_day ymd{day};
+        const uint64_t y = static_cast<int>(ymd.year());
+        const uint64_t m = static_cast<unsigned>(ymd.month());
+        values(d_datekey)[i] = y * 10000 + m * 100 + static_cast<unsigned>(ymd.day());
+        values(d_year)[i] = y;
+        values(d_yearmonthnum)[i] = y * 100 + m;
+        values(d_weeknuminyear)[i] = (day - sys_days{ymd.year() / January / 1}).count() / 7 + 1;
+    }
+    addTable("date", false, {d_datekey, d_year, d_yearmonthnum, d_weeknuminyear});
+
+    addLocationTable("customer", "c", "c_custkey", customers, node);
+    addLocationTable("supplier", "s", "s_suppkey", suppliers, node);
+
+    col_t* p_partkey = newColumn("p_partkey", parts, node);
+    col_t* p_mfgr = newColumn("p_mfgr", parts, node);
+    col_t* p_category = newColumn("p_category", parts, node);
+    col_t* p_brand1 = newColumn("p_brand1", parts, node);
+    fillKeys(p_partkey);
+    fillUniform(p_mfgr, 1, 5);
+    fillUniform(p_category, 1, 5);
+    fillUniform(p_brand1, 1, 40);
+#pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < parts; ++i) {
+        values(p_category)[i] += values(p_mfgr)[i] * 10;
+        values(p_brand1)[i] += values(p_category)[i] * 100;
+    }
+    addTable("part", false, {p_partkey, p_mfgr, p_category, p_brand1});
+
+    col_t* lo_orderdate = newColumn("lo_orderdate", lineorders, node);
+    col_t* lo_custkey = newColumn("lo_custkey", lineorders, node);
+    col_t* lo_partkey = newColumn("lo_partkey", lineorders, node);
+    col_t* lo_suppkey = newColumn("lo_suppkey", lineorders, node);
+    col_t* lo_quantity = newColumn("lo_quantity", lineorders, node);
+    col_t* lo_extendedprice = newColumn("lo_extendedprice", lineorders, node);
+    col_t* lo_discount = newColumn("lo_discount", lineorders, node);
+    col_t* lo_revenue = newColumn("lo_revenue", lineorders, node);
+    col_t* lo_supplycost = newColumn("lo_supplycost", lineorders, node);
+    // lo_orderdate holds day numbers until they are replaced by their date key below
+    fillUniform(lo_orderdate, 0, dates - 1 - ORDER_DATE_GAP);
+    fillUniform(lo_custkey, 1, customers);
+    fillUniform(lo_partkey, 1, parts);
+    fillUniform(lo_suppkey, 1, suppliers);
+    fillUniform(lo_quantity, 1, 50);
+    fillUniform(lo_discount, 0, 10);
+    const uint64_t* datekeys = values(d_datekey);
+#pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < lineorders; ++i) {
+        const uint64_t price = retailPrice(values(lo_partkey)[i]);
+        values(lo_orderdate)[i] = datekeys[values(lo_orderdate)[i]];
+        values(lo_extendedprice)[i] = values(lo_quantity)[i] * price;
+        values(lo_revenue)[i] = values(lo_extendedprice)[i] * (100 - values(lo_discount)[i]) / 100;
+        values(lo_supplycost)[i] = 6 * price / 10;
+    }
+    addTable("lineorder", true, {lo_orderdate, lo_custkey, lo_partkey, lo_suppkey, lo_quantity, lo_extendedprice, lo_discount, lo_revenue, lo_supplycost});
+
+    std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - s_ts;
+    LOG_INFO("[SSB] Generated all tables in " << secs.count() << " s" << std::endl;)
+}
+
+ssb_result_t SSB::execute(size_t query, ssb_mode_t mode, size_t workers) {
+    ssb_result_t result;
+    if (query >= queries().size()) {
+        LOG_ERROR("[SSB] There is no query " << query << "." << std::endl;)
+        result.valid = false;
+        return result;
+    }
+    const ssb_query_t& q = queries()[query];
+    DataCatalog& catalog = DataCatalog::getInstance();
+    workers = std::max<size_t>(workers, 1);
+
+    std::vector<ssb_lookup_t> lookups;
+    for (auto& dimension : q.dimensions) {
+        std::vector<std::string> names = {dimension.key};
+        names.insert(names.end(), dimension.attributes.begin(), dimension.attributes.end());
+        std::vector<col_t*> columns;
+        if (!dimensionColumns(mode, dimension.table, names, columns)) {
+            result.valid = false;
+            return result;
+        }
+
+        const uint64_t* keys = values(columns[0]);
+        const size_t rows = columns[0]->size;
+        std::vector<const uint64_t*> attributes;
+        for (size_t i = 1; i < columns.size(); ++i) {
+            attributes.push_back(values(columns[i]));
+        }
+        for (auto col : columns) {
+            result.bytes += col->sizeInBytes;
+        }
+
+        ssb_lookup_t lookup;
+        if (rows > 0) {
+            const auto [min_key, max_key] = std::minmax_element(keys, keys + rows);
+            lookup.min_key = *min_key;
+            lookup.values.assign(*max_key - *min_key + 1, -1);
+        }
+        for (size_t r = 0; r < rows; ++r) {
+            lookup.values[keys[r] - lookup.min_key] = dimension.select(attributes, r);
+        }
+        lookups.push_back(std::move(lookup));
+    }
+
+    // Foreign keys come first, so fact column d belongs to dimension d
+    std::vector<std::string> names;
+    for (auto& dimension : q.dimensions) {
+        names.push_back(dimension.foreign_key);
+    }
+    auto column_index = [&names](const std::string& name) -> size_t {
+        auto it = std::find(names.begin(), names.end(), name);
+        if (it != names.end()) {
+            return it - names.begin();
+        }
+        names.push_back(name);
+        return names.size() - 1;
+    };
+    size_t first_measure = 0;
+    size_t second_measure = 0;
+    switch (q.measure) {
+        case ssb_measure_t::discounted_price: {
+            first_measure = column_index("lo_extendedprice");
+            second_measure = column_index("lo_discount");
+            break;
+        }
+        case ssb_measure_t::revenue: {
+            first_measure = second_measure = column_index("lo_revenue");
+            break;
+        }
+        case ssb_measure_t::profit: {
+            first_measure = column_index("lo_revenue");
+            second_measure = column_index("lo_supplycost");
+            break;
+        }
+    }
+    const bool filtered = q.min_discount > 0 || q.max_discount < UINT64_MAX || q.min_quantity > 0 || q.max_quantity < UINT64_MAX;
+    const size_t discount = filtered ? column_index("lo_discount") : 0;
+    const size_t quantity = filtered ? column_index("lo_quantity") : 0;
+
+    std::vector<col_t*> fact;
+    for (auto& name : names) {
+        col_t* col = (mode == ssb_mode_t::remote) ? catalog.find_remote(name) : catalog.find_local(name);
+        if (col == nullptr || (!fact.empty() && col->size != fact[0]->size)) {
+            LOG_ERROR("[SSB] Column " << name << " of lineorder not found or of wrong size, generate the SSB tables first." << std::endl;)
+            result.valid = false;
+            return result;
+        }
+        fact.push_back(col);
+        result.bytes += col->sizeInBytes;
+    }
+
+    // Workers take every workers-th block, the planner issues the blocks of all columns ahead of them in scan order
+    const size_t rows = fact[0]->size;
+    const size_t block_rows = std::max<size_t>(catalog.dataCatalog_chunkMaxSize / sizeof(uint64_t), 1);
+    const size_t blocks = (rows + block_rows - 1) / block_rows;
+    std::vector<prefetch_access_t> plan;
+    plan.reserve(blocks * fact.size());
+    for (size_t block = 0; block < blocks; ++block) {
+        const size_t block_size = std::min(block_rows, rows - block * block_rows) * sizeof(uint64_t);
+        for (auto col : fact) {
+            plan.push_back({col, block * block_rows * sizeof(uint64_t), block_size});
+        }
+    }
+    PrefetchPlanner planner(std::move(plan));
+
+    std::vector<const uint64_t*> data;
+    for (auto col : fact) {
+        data.push_back(values(col));
+    }
+
+    std::vector<ssb_result_t> partial(workers);
+    std::vector<std::thread> pool;
+    for (size_t w = 0; w < workers; ++w) {
+        pool.emplace_back([&, w]() -> void {
+            ssb_result_t& local = partial[w];
+            for (size_t block = w; block < blocks; block += workers) {
+                const size_t first_access = block * fact.size();
+                for (size_t c = 0; c < fact.size(); ++c) {
+                    local.valid &= planner.acquire(first_access + c);
+                }
+
+                const size_t end = std::min(rows, (block + 1) * block_rows);
+                for (size_t r = block * block_rows; local.valid && r < end; ++r) {
+                    if (filtered) {
+                        const uint64_t d = data[discount][r];
+                        const uint64_t qty = data[quantity][r];
+                        if (d < q.min_discount || d > q.max_discount || qty < q.min_quantity || qty > q.max_quantity) {
+                            continue;
+                        }
+                    }
+
+                    std::array<uint64_t, 4> key{};
+                    bool match = true;
+                    for (size_t d = 0; d < lookups.size(); ++d) {
+                        const int64_t value = lookups[d].at(data[d][r]);
+                        if (value < 0) {
+                            match = false;
+                            break;
+                        }
+                        key[d] = value;
+                    }
+                    if (!match) {
+                        continue;
+                    }
+
+                    local.groups[key] += measureOf(q.measure, data, first_measure, second_measure, r);
+                    ++local.rows;
+                }
+
+                for (size_t c = 0; c < fact.size(); ++c) {
+                    planner.release(first_access + c);
+                }
+            }
+        });
+    }
+    std::for_each(pool.begin(), pool.end(), [](std::thread& t) { t.join(); });
+
+    for (auto& local : partial) {
+        result.valid &= local.valid;
+        result.rows += local.rows;
+        for (auto& [key, value] : local.groups) {
+            result.groups[key] += value;
+        }
+    }
+    if (!result.valid) {
+        LOG_ERROR("[SSB] Parts of lineorder did not arrive, the result of " << q.name << " is incomplete." << std::endl;)
+    }
+    return result;
+}
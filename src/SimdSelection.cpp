@@ -0,0 +1,361 @@
+#include "SimdSelection.hpp"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+namespace {
+
+template <compare_op_t op, typename T>
+inline bool matches(const T value, const T predicate_1, const T predicate_2) {
+    if constexpr (op == compare_op_t::less_than) return value < predicate_1;
+    if constexpr (op == compare_op_t::less_equal) return value <= predicate_1;
+    if constexpr (op == compare_op_t::greater_than) return value > predicate_1;
+    if constexpr (op == compare_op_t::greater_equal) return value >= predicate_1;
+    if constexpr (op == compare_op_t::equal) return value == predicate_1;
+    if constexpr (op == compare_op_t::between_incl) return value >= predicate_1 && value <= predicate_2;
+    if constexpr (op == compare_op_t::between_excl) return value > predicate_1 && value < predicate_2;
+}
+
+// Branch free, every position is written and only kept if it matches. Also handles the tails of the vector kernels
+template <compare_op_t op, typename T>
+size_t select_scalar(const T* data, const size_t begin, const size_t count, const T predicate_1, const T predicate_2, size_t* out) {
+    size_t n = 0;
+    for (size_t i = begin; i < count; ++i) {
+        out[n] = i;
+        n += matches<op>(data[i], predicate_1, predicate_2);
+    }
+    return n;
+}
+
+template <typename T>
+using kernel_t = size_t (*)(const T*, size_t, T, T, size_t*);
+
+template <typename T, compare_op_t op>
+struct scalar_kernel {
+    static size_t run(const T* data, const size_t count, const T predicate_1, const T predicate_2, size_t* out) {
+        return select_scalar<op>(data, 0, count, predicate_1, predicate_2, out);
+    }
+};
+
+// Instantiates kernel<T, op>::run for the runtime op
+template <typename T, template <typename, compare_op_t> typename kernel>
+kernel_t<T> kernel_for(const compare_op_t op) {
+    switch (op) {
+        case compare_op_t::less_than:
+            return &kernel<T, compare_op_t::less_than>::run;
+        case compare_op_t::less_equal:
+            return &kernel<T, compare_op_t::less_equal>::run;
+        case compare_op_t::greater_than:
+            return &kernel<T, compare_op_t::greater_than>::run;
+        case compare_op_t::greater_equal:
+            return &kernel<T, compare_op_t::greater_equal>::run;
+        case compare_op_t::equal:
+            return &kernel<T, compare_op_t::equal>::run;
+        case compare_op_t::between_incl:
+            return &kernel<T, compare_op_t::between_incl>::run;
+        case compare_op_t::between_excl:
+            return &kernel<T, compare_op_t::between_excl>::run;
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+/* Each kernel compares one vector of values into a bit mask (lane i -> bit i) and turns the mask into positions.
+ * Unsigned integers have no unsigned compares in AVX2, their sign bit is flipped to use the signed ones.
+ * Float compares are ordered, NaN never matches like in the scalar kernel.
+ */
+#pragma GCC push_options
+#pragma GCC target("avx2,popcnt")
+
+namespace avx2 {
+namespace {
+
+// Offsets of the set bits of every 4 bit mask, packed to the front
+constexpr std::array<std::array<uint64_t, 4>, 16> make_emit_offsets() {
+    std::array<std::array<uint64_t, 4>, 16> offsets{};
+    for (uint64_t mask = 0; mask < 16; ++mask) {
+        size_t n = 0;
+        for (uint64_t lane = 0; lane < 4; ++lane) {
+            if (mask & (1u << lane)) offsets[mask][n++] = lane;
+        }
+    }
+    return offsets;
+}
+alignas(32) constexpr auto EMIT_OFFSETS = make_emit_offsets();
+
+// Stores 4 positions per nibble of mask, of which the popcount are valid
+inline size_t emit(const uint32_t mask, const size_t lanes, const size_t base, size_t* out) {
+    size_t n = 0;
+    __m256i position = _mm256_set1_epi64x(base);
+    const __m256i step = _mm256_set1_epi64x(4);
+    for (size_t lane = 0; lane < lanes; lane += 4) {
+        const uint32_t nibble = (mask >> lane) & 0xF;
+        const __m256i offsets = _mm256_load_si256(reinterpret_cast<const __m256i*>(EMIT_OFFSETS[nibble].data()));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + n), _mm256_add_epi64(position, offsets));
+        n += _mm_popcnt_u32(nibble);
+        position = _mm256_add_epi64(position, step);
+    }
+    return n;
+}
+
+template <typename T>
+struct traits;
+
+template <>
+struct traits<uint8_t> {
+    static constexpr size_t LANES = 32;
+    static constexpr uint32_t FULL = 0xFFFFFFFF;
+    static __m256i set1(const uint8_t value) { return _mm256_set1_epi8(static_cast<char>(value ^ 0x80)); }
+    static __m256i load(const uint8_t* data) {
+        return _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)), _mm256_set1_epi8(static_cast<char>(0x80)));
+    }
+    static uint32_t gt(const __m256i a, const __m256i b) { return _mm256_movemask_epi8(_mm256_cmpgt_epi8(a, b)); }
+    static uint32_t ge(const __m256i a, const __m256i b) { return ~gt(b, a) & FULL; }
+    static uint32_t eq(const __m256i a, const __m256i b) { return _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)); }
+};
+
+template <>
+struct traits<uint64_t> {
+    static constexpr size_t LANES = 4;
+    static constexpr uint32_t FULL = 0xF;
+    static __m256i set1(const uint64_t value) { return _mm256_set1_epi64x(value ^ (1ull << 63)); }
+    static __m256i load(const uint64_t* data) {
+        return _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)), _mm256_set1_epi64x(1ull << 63));
+    }
+    static uint32_t gt(const __m256i a, const __m256i b) { return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(a, b))); }
+    static uint32_t ge(const __m256i a, const __m256i b) { return ~gt(b, a) & FULL; }
+    static uint32_t eq(const __m256i a, const __m256i b) { return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b))); }
+};
+
+template <>
+struct traits<float> {
+    static constexpr size_t LANES = 8;
+    static __m256 set1(const float value) { return _mm256_set1_ps(value); }
+    static __m256 load(const float* data) { return _mm256_loadu_ps(data); }
+    static uint32_t gt(const __m256 a, const __m256 b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+    static uint32_t ge(const __m256 a, const __m256 b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GE_OQ)); }
+    static uint32_t eq(const __m256 a, const __m256 b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+};
+
+template <>
+struct traits<double> {
+    static constexpr size_t LANES = 4;
+    static __m256d set1(const double value) { return _mm256_set1_pd(value); }
+    static __m256d load(const double* data) { return _mm256_loadu_pd(data); }
+    static uint32_t gt(const __m256d a, const __m256d b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GT_OQ)); }
+    static uint32_t ge(const __m256d a, const __m256d b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GE_OQ)); }
+    static uint32_t eq(const __m256d a, const __m256d b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+};
+
+template <typename T, compare_op_t op, typename vec_t>
+inline uint32_t match_mask(const vec_t value, const vec_t predicate_1, const vec_t predicate_2) {
+    using tr = traits<T>;
+    if constexpr (op == compare_op_t::less_than) return tr::gt(predicate_1, value);
+    if constexpr (op == compare_op_t::less_equal) return tr::ge(predicate_1, value);
+    if constexpr (op == compare_op_t::greater_than) return tr::gt(value, predicate_1);
+    if constexpr (op == compare_op_t::greater_equal) return tr::ge(value, predicate_1);
+    if constexpr (op == compare_op_t::equal) return tr::eq(value, predicate_1);
+    if constexpr (op == compare_op_t::between_incl) return tr::ge(value, predicate_1) & tr::ge(predicate_2, value);
+    if constexpr (op == compare_op_t::between_excl) return tr::gt(value, predicate_1) & tr::gt(predicate_2, value);
+}
+
+template <typename T, compare_op_t op>
+struct kernel {
+    static size_t run(const T* data, const size_t count, const T predicate_1, const T predicate_2, size_t* out) {
+        using tr = traits<T>;
+        const auto p1 = tr::set1(predicate_1);
+        const auto p2 = tr::set1(predicate_2);
+        size_t n = 0;
+        size_t i = 0;
+        for (; i + tr::LANES <= count; i += tr::LANES) {
+            const uint32_t mask = match_mask<T, op>(tr::load(data + i), p1, p2);
+            if (mask) n += emit(mask, tr::LANES, i, out + n);
+        }
+        return n + select_scalar<op>(data, i, count, predicate_1, predicate_2, out + n);
+    }
+};
+
+}  // namespace
+}  // namespace avx2
+
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw,popcnt")
+
+namespace avx512 {
+namespace {
+
+// Compresses the positions of the set bits 8 lanes at a time, a full vector is stored for each
+inline size_t emit(const uint64_t mask, const size_t lanes, const size_t base, size_t* out) {
+    size_t n = 0;
+    __m512i position = _mm512_add_epi64(_mm512_set1_epi64(base), _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0));
+    const __m512i step = _mm512_set1_epi64(8);
+    for (size_t lane = 0; lane < lanes; lane += 8) {
+        const __mmask8 lane_mask = static_cast<__mmask8>(mask >> lane);
+        // compress + store instead of compressstoreu, the latter is microcoded on some cores
+        _mm512_storeu_si512(out + n, _mm512_maskz_compress_epi64(lane_mask, position));
+        n += _mm_popcnt_u32(lane_mask);
+        position = _mm512_add_epi64(position, step);
+    }
+    return n;
+}
+
+template <typename T>
+struct traits;
+
+template <>
+struct traits<uint8_t> {
+    static constexpr size_t LANES = 64;
+    static __m512i set1(const uint8_t value) { return _mm512_set1_epi8(static_cast<char>(value)); }
+    static __m512i load(const uint8_t* data) { return _mm512_loadu_si512(data); }
+    static uint64_t gt(const __m512i a, const __m512i b) { return _mm512_cmpgt_epu8_mask(a, b); }
+    static uint64_t ge(const __m512i a, const __m512i b) { return _mm512_cmpge_epu8_mask(a, b); }
+    static uint64_t eq(const __m512i a, const __m512i b) { return _mm512_cmpeq_epu8_mask(a, b); }
+};
+
+template <>
+struct traits<uint64_t> {
+    static constexpr size_t LANES = 8;
+    static __m512i set1(const uint64_t value) { return _mm512_set1_epi64(value); }
+    static __m512i load(const uint64_t* data) { return _mm512_loadu_si512(data); }
+    static uint64_t gt(const __m512i a, const __m512i b) { return _mm512_cmpgt_epu64_mask(a, b); }
+    static uint64_t ge(const __m512i a, const __m512i b) { return _mm512_cmpge_epu64_mask(a, b); }
+    static uint64_t eq(const __m512i a, const __m512i b) { return _mm512_cmpeq_epu64_mask(a, b); }
+};
+
+template <>
+struct traits<float> {
+    static constexpr size_t LANES = 16;
+    static __m512 set1(const float value) { return _mm512_set1_ps(value); }
+    static __m512 load(const float* data) { return _mm512_loadu_ps(data); }
+    static uint64_t gt(const __m512 a, const __m512 b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+    static uint64_t ge(const __m512 a, const __m512 b) { return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ); }
+    static uint64_t eq(const __m512 a, const __m512 b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+};
+
+template <>
+struct traits<double> {
+    static constexpr size_t LANES = 8;
+    static __m512d set1(const double value) { return _mm512_set1_pd(value); }
+    static __m512d load(const double* data) { return _mm512_loadu_pd(data); }
+    static uint64_t gt(const __m512d a, const __m512d b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+    static uint64_t ge(const __m512d a, const __m512d b) { return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ); }
+    static uint64_t eq(const __m512d a, const __m512d b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+};
+
+template <typename T, compare_op_t op, typename vec_t>
+inline uint64_t match_mask(const vec_t value, const vec_t predicate_1, const vec_t predicate_2) {
+    using tr = traits<T>;
+    if constexpr (op == compare_op_t::less_than) return tr::gt(predicate_1, value);
+    if constexpr (op == compare_op_t::less_equal) return tr::ge(predicate_1, value);
+    if constexpr (op == compare_op_t::greater_than) return tr::gt(value, predicate_1);
+    if constexpr (op == compare_op_t::greater_equal) return tr::ge(value, predicate_1);
+    if constexpr (op == compare_op_t::equal) return tr::eq(value, predicate_1);
+    if constexpr (op == compare_op_t::between_incl) return tr::ge(value, predicate_1) & tr::ge(predicate_2, value);
+    if constexpr (op == compare_op_t::between_excl) return tr::gt(value, predicate_1) & tr::gt(predicate_2, value);
+}
+
+template <typename T, compare_op_t op>
+struct kernel {
+    static size_t run(const T* data, const size_t count, const T predicate_1, const T predicate_2, size_t* out) {
+        using tr = traits<T>;
+        const auto p1 = tr::set1(predicate_1);
+        const auto p2 = tr::set1(predicate_2);
+        size_t n = 0;
+        size_t i = 0;
+        for (; i + tr::LANES <= count; i += tr::LANES) {
+            const uint64_t mask = match_mask<T, op>(tr::load(data + i), p1, p2);
+            if (mask) n += emit(mask, tr::LANES, i, out + n);
+        }
+        return n + select_scalar<op>(data, i, count, predicate_1, predicate_2, out + n);
+    }
+};
+
+}  // namespace
+}  // namespace avx512
+
+#pragma GCC pop_options
+
+namespace {
+
+std::atomic<simd_level_t> currentLevel{SimdSelection::detected_level()};
+
+}  // namespace
+
+simd_level_t SimdSelection::detected_level() {
+    static const simd_level_t detected = []() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) return simd_level_t::avx512;
+        if (__builtin_cpu_supports("avx2")) return simd_level_t::avx2;
+        return simd_level_t::scalar;
+    }();
+    return detected;
+}
+
+simd_level_t SimdSelection::level() {
+    return currentLevel.load(std::memory_order_relaxed);
+}
+
+simd_level_t SimdSelection::set_level(const simd_level_t level) {
+    const simd_level_t used = std::min(level, detected_level());
+    currentLevel.store(used, std::memory_order_relaxed);
+    return used;
+}
+
+std::string SimdSelection::level_to_string(const simd_level_t level) {
+    switch (level) {
+        case simd_level_t::scalar:
+            return "scalar";
+        case simd_level_t::avx2:
+            return "avx2";
+        case simd_level_t::avx512:
+            return "avx512";
+    }
+    return "unknown";
+}
+
+std::string SimdSelection::op_to_string(const compare_op_t op) {
+    switch (op) {
+        case compare_op_t::less_than:
+            return "less_than";
+        case compare_op_t::less_equal:
+            return "less_equal";
+        case compare_op_t::greater_than:
+            return "greater_than";
+        case compare_op_t::greater_equal:
+            return "greater_equal";
+        case compare_op_t::equal:
+            return "equal";
+        case compare_op_t::between_incl:
+            return "between_incl";
+        case compare_op_t::between_excl:
+            return "between_excl";
+    }
+    return "unknown";
+}
+
+template <typename T>
+size_t SimdSelection::select(const compare_op_t op, const T* data, const size_t count, const T predicate_1, const T predicate_2, size_t* out) {
+    kernel_t<T> kernel;
+    switch (level()) {
+        case simd_level_t::avx512:
+            kernel = kernel_for<T, avx512::kernel>(op);
+            break;
+        case simd_level_t::avx2:
+            kernel = kernel_for<T, avx2::kernel>(op);
+            break;
+        default:
+            kernel = kernel_for<T, scalar_kernel>(op);
+    }
+    return kernel(data, count, predicate_1, predicate_2, out);
+}
+
+template size_t SimdSelection::select<uint8_t>(compare_op_t, const uint8_t*, size_t, uint8_t, uint8_t, size_t*);
+template size_t SimdSelection::select<uint64_t>(compare_op_t, const uint64_t*, size_t, uint64_t, uint64_t, size_t*);
+template size_t SimdSelection::select<float>(compare_op_t, const float*, size_t, float, float, size_t*);
+template size_t SimdSelection::select<double>(compare_op_t, const double*, size_t, double, double, size_t*);
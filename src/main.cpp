@@ -59,9 +59,10 @@ int main(int argc, char *argv[]) {
     ConnectionManager::getInstance().configuration->add(argc, argv);
     Logger::LoadConfiguration();
 
-    if (!checkLinkUp()) {
-        LOG_FATAL("Could not find 'Active' state in ibstat, please check! Maybe you need to run \"sudo opensm -B\" on any server." << std::endl);
-        exit(-2);
+    // Without InfiniBand the catalog still works over the socket (connectSocket / listenSocket) or shared memory transport
+    const bool rdmaAvailable = checkLinkUp();
+    if (!rdmaAvailable) {
+        LOG_WARNING("Could not find 'Active' state in ibstat, RDMA connections are unavailable. Maybe you need to run \"sudo opensm -B\" on any server." << std::endl);
     }
 
     struct bitmask *mask = numa_bitmask_alloc(numa_num_possible_nodes());
@@ -83,9 +84,9 @@ int main(int argc, char *argv[]) {
     };
 
     TaskManager::getInstance().setGlobalAbortFunction(globalExit);
-    if (ConnectionManager::getInstance().configuration->get<bool>(MEMO_DEFAULT_CONNECTION_AUTO_LISTEN)) {
+    if (rdmaAvailable && ConnectionManager::getInstance().configuration->get<bool>(MEMO_DEFAULT_CONNECTION_AUTO_LISTEN)) {
         std::thread([]() -> void { TaskManager::getInstance().executeByIdent("listenConnection"); }).detach();
-    } else if (ConnectionManager::getInstance().configuration->get<bool>(MEMO_DEFAULT_CONNECTION_AUTO_INITIATE)) {
+    } else if (rdmaAvailable && ConnectionManager::getInstance().configuration->get<bool>(MEMO_DEFAULT_CONNECTION_AUTO_INITIATE)) {
         std::thread([]() -> void { TaskManager::getInstance().executeByIdent("openConnection"); }).detach();
     }
 